@@ -4,6 +4,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /**
  * \file
@@ -138,4 +139,53 @@ i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* dat
  */
 i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout);
 
+#if (defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)) || defined(__DOXYGEN__)
+
+/**
+ * \brief A single write within a chain started by `i2c_transmit_chain_async()`.
+ */
+typedef struct i2c_async_transfer_t {
+    /** The 7-bit I2C address of the device. */
+    uint8_t address;
+    /** The bytes to send, usually the register address followed by the values to write. Must stay valid until the chain completes. */
+    const uint8_t* data;
+    /** The number of bytes in `data`. */
+    uint16_t length;
+} i2c_async_transfer_t;
+
+/**
+ * \brief Called once a chain of transfers has been sent.
+ *
+ * This runs from the I2C thread, not the main loop, so it should do little more than set a flag.
+ *
+ * \param status `I2C_STATUS_SUCCESS` if every transfer succeeded, otherwise the status of the last failed transfer.
+ */
+typedef void (*i2c_async_callback_t)(i2c_status_t status);
+
+/**
+ * \brief Send a chain of writes in the background (ChibiOS only, requires `I2C_ASYNC_ENABLE`).
+ *
+ * The transfers are sent in order by a dedicated thread and the call returns immediately. The other I2C functions wait for the bus while a chain is in progress.
+ *
+ * \param transfers The writes to send. The array and the data it points to must stay valid until the chain completes.
+ * \param count The number of transfers.
+ * \param timeout The time in milliseconds to wait for a response to each transfer.
+ * \param callback Called once the chain has been sent, may be `NULL`.
+ *
+ * \return `I2C_STATUS_ERROR` if a previous chain is still in progress, otherwise `I2C_STATUS_SUCCESS`.
+ */
+i2c_status_t i2c_transmit_chain_async(const i2c_async_transfer_t* transfers, uint8_t count, uint16_t timeout, i2c_async_callback_t callback);
+
+/**
+ * \brief Check whether a chain started by `i2c_transmit_chain_async()` is still in progress.
+ */
+bool i2c_async_busy(void);
+
+/**
+ * \brief Wait until any chain started by `i2c_transmit_chain_async()` has completed.
+ */
+void i2c_async_wait(void);
+
+#endif
+
 /** \} */
@@ -21,8 +21,12 @@
 #include "i2c_master.h"
 #include "gpio.h"
 #include "wait.h"
+#include <string.h>
 
 #define IS31FL3733_PWM_REGISTER_COUNT 192
+#define IS31FL3733_PWM_CHUNK_SIZE 16
+#define IS31FL3733_PWM_CHUNK_COUNT (IS31FL3733_PWM_REGISTER_COUNT / IS31FL3733_PWM_CHUNK_SIZE)
+#define IS31FL3733_PWM_CHUNK_MASK(reg) ((uint16_t)1 << ((reg) / IS31FL3733_PWM_CHUNK_SIZE))
 #define IS31FL3733_LED_CONTROL_REGISTER_COUNT 24
 
 #ifndef IS31FL3733_I2C_TIMEOUT
@@ -95,19 +99,40 @@ const uint8_t driver_sync[IS31FL3733_DRIVER_COUNT] = {
 // buffers and the transfers in is31fl3733_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 typedef struct is31fl3733_driver_t {
-    uint8_t pwm_buffer[IS31FL3733_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t led_control_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT];
-    bool    led_control_buffer_dirty;
+    uint8_t  pwm_buffer[IS31FL3733_PWM_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty; // One bit per PWM chunk
+    uint8_t  led_control_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT];
+    bool     led_control_buffer_dirty;
 } PACKED is31fl3733_driver_t;
 
 is31fl3733_driver_t driver_buffers[IS31FL3733_DRIVER_COUNT] = {{
     .pwm_buffer               = {0},
-    .pwm_buffer_dirty         = false,
+    .pwm_buffer_dirty         = 0,
     .led_control_buffer       = {0},
     .led_control_buffer_dirty = false,
 }};
 
+#if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+// Shadow of the PWM registers sent in the background by is31fl3733_flush(),
+// so the next frame can be rendered into pwm_buffer while it is in flight.
+// Each transfer is laid out as sent: the register address, then the values.
+
+typedef struct is31fl3733_pwm_transfer_t {
+    uint8_t unlock[2];
+    uint8_t page[2];
+    uint8_t pwm[IS31FL3733_PWM_CHUNK_COUNT][1 + IS31FL3733_PWM_CHUNK_SIZE];
+} is31fl3733_pwm_transfer_t;
+
+static is31fl3733_pwm_transfer_t pwm_transfers[IS31FL3733_DRIVER_COUNT];
+static i2c_async_transfer_t      pwm_transfer_chain[IS31FL3733_DRIVER_COUNT * (2 + IS31FL3733_PWM_CHUNK_COUNT)];
+static volatile bool             pwm_transfer_pending = false;
+static volatile bool             pwm_transfer_failed  = false;
+static uint8_t                   pwm_transfer_count   = 0;
+#    if IS31FL3733_I2C_PERSISTENCE > 0
+static uint8_t pwm_transfer_attempts = 0;
+#    endif
+#endif
+
 void is31fl3733_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3733_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3733_I2C_PERSISTENCE; i++) {
@@ -119,22 +144,40 @@ void is31fl3733_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 }
 
 void is31fl3733_select_page(uint8_t index, uint8_t page) {
+#if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+    // A background flush would change the page under our feet.
+    i2c_async_wait();
+#endif
     is31fl3733_write_register(index, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
     is31fl3733_write_register(index, IS31FL3733_REG_COMMAND, page);
 }
 
 void is31fl3733_write_pwm_buffer(uint8_t index) {
     // Assumes page 1 is already selected.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
+    // Transmit the dirty PWM register chunks of 16 bytes, runs of adjacent
+    // dirty chunks are merged into a single transfer.
+    uint16_t dirty = driver_buffers[index].pwm_buffer_dirty;
+    uint8_t  chunk = 0;
+
+    while (chunk < IS31FL3733_PWM_CHUNK_COUNT) {
+        if (!(dirty & (1 << chunk))) {
+            chunk++;
+            continue;
+        }
 
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i += 16) {
+        uint8_t first = chunk;
+        while (chunk < IS31FL3733_PWM_CHUNK_COUNT && (dirty & (1 << chunk))) {
+            chunk++;
+        }
+
+        uint8_t i      = first * IS31FL3733_PWM_CHUNK_SIZE;
+        uint8_t length = (chunk - first) * IS31FL3733_PWM_CHUNK_SIZE;
 #if IS31FL3733_I2C_PERSISTENCE > 0
         for (uint8_t j = 0; j < IS31FL3733_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, length, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
         }
 #else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT);
+        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, length, IS31FL3733_I2C_TIMEOUT);
 #endif
     }
 }
@@ -211,7 +254,7 @@ void is31fl3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         driver_buffers[led.driver].pwm_buffer[led.r] = red;
         driver_buffers[led.driver].pwm_buffer[led.g] = green;
         driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= IS31FL3733_PWM_CHUNK_MASK(led.r) | IS31FL3733_PWM_CHUNK_MASK(led.g) | IS31FL3733_PWM_CHUNK_MASK(led.b);
     }
 }
 
@@ -257,7 +300,7 @@ void is31fl3733_update_pwm_buffers(uint8_t index) {
 
         is31fl3733_write_pwm_buffer(index);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
@@ -273,8 +316,86 @@ void is31fl3733_update_led_control_registers(uint8_t index) {
     }
 }
 
+#if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+static void is31fl3733_flush_complete(i2c_status_t status) {
+    // Runs on the I2C thread, the failure is handled by the next is31fl3733_flush().
+    pwm_transfer_failed  = status != I2C_STATUS_SUCCESS;
+    pwm_transfer_pending = false;
+}
+
+static void is31fl3733_flush_start(void) {
+    pwm_transfer_pending = true;
+    if (i2c_transmit_chain_async(pwm_transfer_chain, pwm_transfer_count, IS31FL3733_I2C_TIMEOUT, is31fl3733_flush_complete) != I2C_STATUS_SUCCESS) {
+        // Another chain is using the bus, try again on the next flush.
+        is31fl3733_flush_complete(I2C_STATUS_ERROR);
+    }
+}
+
+bool is31fl3733_flush_pending(void) {
+    return pwm_transfer_pending;
+}
+
+void is31fl3733_flush(void) {
+    if (pwm_transfer_pending) {
+        // The previous frame is still being sent, pwm_buffer stays dirty until the next flush.
+        return;
+    }
+
+    if (pwm_transfer_failed) {
+        pwm_transfer_failed = false;
+#    if IS31FL3733_I2C_PERSISTENCE > 0
+        if (++pwm_transfer_attempts < IS31FL3733_I2C_PERSISTENCE) {
+            // Send the same chain again, as the synchronous writes are retried.
+            is31fl3733_flush_start();
+            return;
+        }
+#    endif
+        // Give up on that chain and send the whole frame again.
+        for (uint8_t i = 0; i < IS31FL3733_DRIVER_COUNT; i++) {
+            driver_buffers[i].pwm_buffer_dirty = (uint16_t)((1UL << IS31FL3733_PWM_CHUNK_COUNT) - 1);
+        }
+    }
+#    if IS31FL3733_I2C_PERSISTENCE > 0
+    pwm_transfer_attempts = 0;
+#    endif
+
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < IS31FL3733_DRIVER_COUNT; i++) {
+        if (!driver_buffers[i].pwm_buffer_dirty) {
+            continue;
+        }
+
+        is31fl3733_pwm_transfer_t *transfer = &pwm_transfers[i];
+        uint8_t                    address  = i2c_addresses[i] << 1;
+
+        transfer->unlock[0]         = IS31FL3733_REG_COMMAND_WRITE_LOCK;
+        transfer->unlock[1]         = IS31FL3733_COMMAND_WRITE_LOCK_MAGIC;
+        pwm_transfer_chain[count++] = (i2c_async_transfer_t){address, transfer->unlock, sizeof(transfer->unlock)};
+        transfer->page[0]           = IS31FL3733_REG_COMMAND;
+        transfer->page[1]           = IS31FL3733_COMMAND_PWM;
+        pwm_transfer_chain[count++] = (i2c_async_transfer_t){address, transfer->page, sizeof(transfer->page)};
+
+        for (uint8_t j = 0; j < IS31FL3733_PWM_CHUNK_COUNT; j++) {
+            if (!(driver_buffers[i].pwm_buffer_dirty & (1 << j))) {
+                continue;
+            }
+            transfer->pwm[j][0] = j * IS31FL3733_PWM_CHUNK_SIZE;
+            memcpy(&transfer->pwm[j][1], driver_buffers[i].pwm_buffer + j * IS31FL3733_PWM_CHUNK_SIZE, IS31FL3733_PWM_CHUNK_SIZE);
+            pwm_transfer_chain[count++] = (i2c_async_transfer_t){address, transfer->pwm[j], sizeof(transfer->pwm[j])};
+        }
+
+        driver_buffers[i].pwm_buffer_dirty = 0;
+    }
+
+    if (count > 0) {
+        pwm_transfer_count = count;
+        is31fl3733_flush_start();
+    }
+}
+#else
 void is31fl3733_flush(void) {
     for (uint8_t i = 0; i < IS31FL3733_DRIVER_COUNT; i++) {
         is31fl3733_update_pwm_buffers(i);
     }
 }
+#endif
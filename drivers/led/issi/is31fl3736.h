@@ -100,6 +100,10 @@ void is31fl3736_update_led_control_registers(uint8_t index);
 
 void is31fl3736_flush(void);
 
+#if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+bool is31fl3736_flush_pending(void);
+#endif
+
 #define IS31FL3736_PDR_0_OHM 0b000   // No pull-down resistor
 #define IS31FL3736_PDR_0K5_OHM 0b001 // 0.5 kOhm resistor
 #define IS31FL3736_PDR_1K_OHM 0b010  // 1 kOhm resistor
@@ -21,9 +21,17 @@
 #include "i2c_master.h"
 #include "gpio.h"
 #include "wait.h"
+#include <string.h>
 
 #define IS31FL3741_PWM_0_REGISTER_COUNT 180
 #define IS31FL3741_PWM_1_REGISTER_COUNT 171
+#define IS31FL3741_PWM_0_CHUNK_SIZE 30
+#define IS31FL3741_PWM_0_CHUNK_COUNT (IS31FL3741_PWM_0_REGISTER_COUNT / IS31FL3741_PWM_0_CHUNK_SIZE)
+#define IS31FL3741_PWM_1_CHUNK_SIZE 19
+#define IS31FL3741_PWM_1_CHUNK_COUNT (IS31FL3741_PWM_1_REGISTER_COUNT / IS31FL3741_PWM_1_CHUNK_SIZE)
+// PWM0 chunks take the low bits of pwm_buffer_dirty, PWM1 chunks the bits above them.
+#define IS31FL3741_PWM_0_CHUNK_ALL ((uint16_t)((1UL << IS31FL3741_PWM_0_CHUNK_COUNT) - 1))
+#define IS31FL3741_PWM_CHUNK_ALL ((uint16_t)((1UL << (IS31FL3741_PWM_0_CHUNK_COUNT + IS31FL3741_PWM_1_CHUNK_COUNT)) - 1))
 #define IS31FL3741_SCALING_0_REGISTER_COUNT 180
 #define IS31FL3741_SCALING_1_REGISTER_COUNT 171
 
@@ -75,23 +83,46 @@ const uint8_t i2c_addresses[IS31FL3741_DRIVER_COUNT] = {
 // buffers and the transfers in is31fl3741_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 typedef struct is31fl3741_driver_t {
-    uint8_t pwm_buffer_0[IS31FL3741_PWM_0_REGISTER_COUNT];
-    uint8_t pwm_buffer_1[IS31FL3741_PWM_1_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t scaling_buffer_0[IS31FL3741_SCALING_0_REGISTER_COUNT];
-    uint8_t scaling_buffer_1[IS31FL3741_SCALING_1_REGISTER_COUNT];
-    bool    scaling_buffer_dirty;
+    uint8_t  pwm_buffer_0[IS31FL3741_PWM_0_REGISTER_COUNT];
+    uint8_t  pwm_buffer_1[IS31FL3741_PWM_1_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty; // One bit per PWM chunk
+    uint8_t  scaling_buffer_0[IS31FL3741_SCALING_0_REGISTER_COUNT];
+    uint8_t  scaling_buffer_1[IS31FL3741_SCALING_1_REGISTER_COUNT];
+    bool     scaling_buffer_dirty;
 } PACKED is31fl3741_driver_t;
 
 is31fl3741_driver_t driver_buffers[IS31FL3741_DRIVER_COUNT] = {{
     .pwm_buffer_0         = {0},
     .pwm_buffer_1         = {0},
-    .pwm_buffer_dirty     = false,
+    .pwm_buffer_dirty     = 0,
     .scaling_buffer_0     = {0},
     .scaling_buffer_1     = {0},
     .scaling_buffer_dirty = false,
 }};
 
+#if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+// Shadow of the PWM registers sent in the background by is31fl3741_flush(),
+// so the next frame can be rendered into the PWM buffers while it is in flight.
+// Each transfer is laid out as sent: the register address, then the values.
+
+typedef struct is31fl3741_pwm_transfer_t {
+    uint8_t unlock[2];
+    uint8_t page_0[2];
+    uint8_t pwm_0[IS31FL3741_PWM_0_CHUNK_COUNT][1 + IS31FL3741_PWM_0_CHUNK_SIZE];
+    uint8_t page_1[2];
+    uint8_t pwm_1[IS31FL3741_PWM_1_CHUNK_COUNT][1 + IS31FL3741_PWM_1_CHUNK_SIZE];
+} is31fl3741_pwm_transfer_t;
+
+static is31fl3741_pwm_transfer_t pwm_transfers[IS31FL3741_DRIVER_COUNT];
+static i2c_async_transfer_t      pwm_transfer_chain[IS31FL3741_DRIVER_COUNT * (4 + IS31FL3741_PWM_0_CHUNK_COUNT + IS31FL3741_PWM_1_CHUNK_COUNT)];
+static volatile bool             pwm_transfer_pending = false;
+static volatile bool             pwm_transfer_failed  = false;
+static uint8_t                   pwm_transfer_count   = 0;
+#    if IS31FL3741_I2C_PERSISTENCE > 0
+static uint8_t pwm_transfer_attempts = 0;
+#    endif
+#endif
+
 void is31fl3741_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3741_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3741_I2C_PERSISTENCE; i++) {
@@ -103,39 +134,55 @@ void is31fl3741_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 }
 
 void is31fl3741_select_page(uint8_t index, uint8_t page) {
+#if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+    // A background flush would change the page under our feet.
+    i2c_async_wait();
+#endif
     is31fl3741_write_register(index, IS31FL3741_REG_COMMAND_WRITE_LOCK, IS31FL3741_COMMAND_WRITE_LOCK_MAGIC);
     is31fl3741_write_register(index, IS31FL3741_REG_COMMAND, page);
 }
 
-void is31fl3741_write_pwm_buffer(uint8_t index) {
-    is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_0);
+// Transmits the dirty chunks of one PWM page, runs of adjacent dirty chunks
+// are merged into a single transfer.
+static void is31fl3741_write_pwm_chunks(uint8_t index, const uint8_t *buffer, uint8_t chunk_size, uint8_t chunk_count, uint16_t dirty) {
+    uint8_t chunk = 0;
+
+    while (chunk < chunk_count) {
+        if (!(dirty & (1 << chunk))) {
+            chunk++;
+            continue;
+        }
 
-    // Transmit PWM0 registers in 6 transfers of 30 bytes.
+        uint8_t first = chunk;
+        while (chunk < chunk_count && (dirty & (1 << chunk))) {
+            chunk++;
+        }
 
-    // Iterate over the pwm_buffer_0 contents at 30 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3741_PWM_0_REGISTER_COUNT; i += 30) {
+        uint8_t i      = first * chunk_size;
+        uint8_t length = (chunk - first) * chunk_size;
 #if IS31FL3741_I2C_PERSISTENCE > 0
         for (uint8_t j = 0; j < IS31FL3741_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_0 + i, 30, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+            if (i2c_write_register(i2c_addresses[index] << 1, i, buffer + i, length, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
         }
 #else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_0 + i, 30, IS31FL3741_I2C_TIMEOUT);
+        i2c_write_register(i2c_addresses[index] << 1, i, buffer + i, length, IS31FL3741_I2C_TIMEOUT);
 #endif
     }
+}
 
-    is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_1);
+void is31fl3741_write_pwm_buffer(uint8_t index) {
+    uint16_t dirty = driver_buffers[index].pwm_buffer_dirty;
 
-    // Transmit PWM1 registers in 9 transfers of 19 bytes.
+    // Only switch to the pages that have changed.
+    if (dirty & IS31FL3741_PWM_0_CHUNK_ALL) {
+        is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_0);
+        is31fl3741_write_pwm_chunks(index, driver_buffers[index].pwm_buffer_0, IS31FL3741_PWM_0_CHUNK_SIZE, IS31FL3741_PWM_0_CHUNK_COUNT, dirty);
+    }
 
-    // Iterate over the pwm_buffer_1 contents at 19 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3741_PWM_1_REGISTER_COUNT; i += 19) {
-#if IS31FL3741_I2C_PERSISTENCE > 0
-        for (uint8_t i = 0; i < IS31FL3741_I2C_PERSISTENCE; i++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT);
-#endif
+    dirty >>= IS31FL3741_PWM_0_CHUNK_COUNT;
+    if (dirty) {
+        is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_1);
+        is31fl3741_write_pwm_chunks(index, driver_buffers[index].pwm_buffer_1, IS31FL3741_PWM_1_CHUNK_SIZE, IS31FL3741_PWM_1_CHUNK_COUNT, dirty);
     }
 }
 
@@ -196,8 +243,10 @@ uint8_t get_pwm_value(uint8_t driver, uint16_t reg) {
 void set_pwm_value(uint8_t driver, uint16_t reg, uint8_t value) {
     if (reg & 0x100) {
         driver_buffers[driver].pwm_buffer_1[reg & 0xFF] = value;
+        driver_buffers[driver].pwm_buffer_dirty |= (uint16_t)1 << (IS31FL3741_PWM_0_CHUNK_COUNT + (reg & 0xFF) / IS31FL3741_PWM_1_CHUNK_SIZE);
     } else {
         driver_buffers[driver].pwm_buffer_0[reg] = value;
+        driver_buffers[driver].pwm_buffer_dirty |= (uint16_t)1 << (reg / IS31FL3741_PWM_0_CHUNK_SIZE);
     }
 }
 
@@ -214,7 +263,6 @@ void is31fl3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         set_pwm_value(led.driver, led.r, red);
         set_pwm_value(led.driver, led.g, green);
         set_pwm_value(led.driver, led.b, blue);
-        driver_buffers[led.driver].pwm_buffer_dirty = true;
     }
 }
 
@@ -247,7 +295,7 @@ void is31fl3741_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
         is31fl3741_write_pwm_buffer(index);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
@@ -255,7 +303,6 @@ void is31fl3741_set_pwm_buffer(const is31fl3741_led_t *pled, uint8_t red, uint8_
     set_pwm_value(pled->driver, pled->r, red);
     set_pwm_value(pled->driver, pled->g, green);
     set_pwm_value(pled->driver, pled->b, blue);
-    driver_buffers[pled->driver].pwm_buffer_dirty = true;
 }
 
 void is31fl3741_update_led_control_registers(uint8_t index) {
@@ -283,8 +330,109 @@ void is31fl3741_set_scaling_registers(const is31fl3741_led_t *pled, uint8_t red,
     driver_buffers[pled->driver].scaling_buffer_dirty = true;
 }
 
+#if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+static void is31fl3741_flush_complete(i2c_status_t status) {
+    // Runs on the I2C thread, the failure is handled by the next is31fl3741_flush().
+    pwm_transfer_failed  = status != I2C_STATUS_SUCCESS;
+    pwm_transfer_pending = false;
+}
+
+static void is31fl3741_flush_start(void) {
+    pwm_transfer_pending = true;
+    if (i2c_transmit_chain_async(pwm_transfer_chain, pwm_transfer_count, IS31FL3741_I2C_TIMEOUT, is31fl3741_flush_complete) != I2C_STATUS_SUCCESS) {
+        // Another chain is using the bus, try again on the next flush.
+        is31fl3741_flush_complete(I2C_STATUS_ERROR);
+    }
+}
+
+bool is31fl3741_flush_pending(void) {
+    return pwm_transfer_pending;
+}
+
+void is31fl3741_flush(void) {
+    if (pwm_transfer_pending) {
+        // The previous frame is still being sent, the PWM buffers stay dirty until the next flush.
+        return;
+    }
+
+    if (pwm_transfer_failed) {
+        pwm_transfer_failed = false;
+#    if IS31FL3741_I2C_PERSISTENCE > 0
+        if (++pwm_transfer_attempts < IS31FL3741_I2C_PERSISTENCE) {
+            // Send the same chain again, as the synchronous writes are retried.
+            is31fl3741_flush_start();
+            return;
+        }
+#    endif
+        // Give up on that chain and send the whole frame again.
+        for (uint8_t i = 0; i < IS31FL3741_DRIVER_COUNT; i++) {
+            driver_buffers[i].pwm_buffer_dirty = IS31FL3741_PWM_CHUNK_ALL;
+        }
+    }
+#    if IS31FL3741_I2C_PERSISTENCE > 0
+    pwm_transfer_attempts = 0;
+#    endif
+
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < IS31FL3741_DRIVER_COUNT; i++) {
+        if (!driver_buffers[i].pwm_buffer_dirty) {
+            continue;
+        }
+
+        is31fl3741_pwm_transfer_t *transfer = &pwm_transfers[i];
+        uint8_t                    address  = i2c_addresses[i] << 1;
+        uint16_t                   dirty    = driver_buffers[i].pwm_buffer_dirty;
+
+        transfer->unlock[0] = IS31FL3741_REG_COMMAND_WRITE_LOCK;
+        transfer->unlock[1] = IS31FL3741_COMMAND_WRITE_LOCK_MAGIC;
+
+        // Only switch to the pages that have changed.
+        if (dirty & IS31FL3741_PWM_0_CHUNK_ALL) {
+            pwm_transfer_chain[count++] = (i2c_async_transfer_t){address, transfer->unlock, sizeof(transfer->unlock)};
+            transfer->page_0[0]         = IS31FL3741_REG_COMMAND;
+            transfer->page_0[1]         = IS31FL3741_COMMAND_PWM_0;
+            pwm_transfer_chain[count++] = (i2c_async_transfer_t){address, transfer->page_0, sizeof(transfer->page_0)};
+
+            for (uint8_t j = 0; j < IS31FL3741_PWM_0_CHUNK_COUNT; j++) {
+                if (!(dirty & (1 << j))) {
+                    continue;
+                }
+                transfer->pwm_0[j][0] = j * IS31FL3741_PWM_0_CHUNK_SIZE;
+                memcpy(&transfer->pwm_0[j][1], driver_buffers[i].pwm_buffer_0 + j * IS31FL3741_PWM_0_CHUNK_SIZE, IS31FL3741_PWM_0_CHUNK_SIZE);
+                pwm_transfer_chain[count++] = (i2c_async_transfer_t){address, transfer->pwm_0[j], sizeof(transfer->pwm_0[j])};
+            }
+        }
+
+        dirty >>= IS31FL3741_PWM_0_CHUNK_COUNT;
+        if (dirty) {
+            // The write lock has to be released again before every page change.
+            pwm_transfer_chain[count++] = (i2c_async_transfer_t){address, transfer->unlock, sizeof(transfer->unlock)};
+            transfer->page_1[0]         = IS31FL3741_REG_COMMAND;
+            transfer->page_1[1]         = IS31FL3741_COMMAND_PWM_1;
+            pwm_transfer_chain[count++] = (i2c_async_transfer_t){address, transfer->page_1, sizeof(transfer->page_1)};
+
+            for (uint8_t j = 0; j < IS31FL3741_PWM_1_CHUNK_COUNT; j++) {
+                if (!(dirty & (1 << j))) {
+                    continue;
+                }
+                transfer->pwm_1[j][0] = j * IS31FL3741_PWM_1_CHUNK_SIZE;
+                memcpy(&transfer->pwm_1[j][1], driver_buffers[i].pwm_buffer_1 + j * IS31FL3741_PWM_1_CHUNK_SIZE, IS31FL3741_PWM_1_CHUNK_SIZE);
+                pwm_transfer_chain[count++] = (i2c_async_transfer_t){address, transfer->pwm_1[j], sizeof(transfer->pwm_1[j])};
+            }
+        }
+
+        driver_buffers[i].pwm_buffer_dirty = 0;
+    }
+
+    if (count > 0) {
+        pwm_transfer_count = count;
+        is31fl3741_flush_start();
+    }
+}
+#else
 void is31fl3741_flush(void) {
     for (uint8_t i = 0; i < IS31FL3741_DRIVER_COUNT; i++) {
         is31fl3741_update_pwm_buffers(i);
     }
 }
+#endif
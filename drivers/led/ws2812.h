@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include "util.h"
 
 /*
@@ -95,3 +96,10 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 void ws2812_flush(void);
 
 void ws2812_rgb_to_rgbw(ws2812_led_t *led);
+
+#ifdef WS2812_SPI
+/*
+ * Whether the previous ws2812_flush() is still being sent in the background.
+ */
+bool ws2812_flush_pending(void);
+#endif
@@ -34,6 +34,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define TIMER_RAW TCNT0
 #define TIMER_RAW_TOP (TIMER_RAW_FREQ / 1000)
 
+// Set once TIMER_RAW wraps, until the interrupt counting milliseconds has run
+#if defined(__AVR_ATmega32A__)
+#    define TIMER_RAW_PENDING (TIFR & _BV(OCF0))
+#elif defined(__AVR_ATtiny85__)
+#    define TIMER_RAW_PENDING (TIFR & _BV(OCF0A))
+#else
+#    define TIMER_RAW_PENDING (TIFR0 & _BV(OCF0A))
+#endif
+
 #if (TIMER_RAW_TOP > 255)
 #    error "Timer0 can't count 1ms at this clock freq. Use larger prescaler."
 #endif
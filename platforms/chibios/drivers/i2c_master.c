@@ -128,6 +128,26 @@ static i2c_status_t i2c_epilogue(const msg_t status) {
     return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
 }
 
+#if defined(I2C_ASYNC_ENABLE) || defined(SPLIT_TRANSPORT_THREAD)
+// Serialises the blocking functions with chains sent by the I2C thread, and with the split transport thread.
+static MUTEX_DECL(i2c_bus_mutex);
+
+static inline void i2c_bus_lock(void) {
+    chMtxLock(&i2c_bus_mutex);
+}
+
+static inline i2c_status_t i2c_bus_unlock(i2c_status_t status) {
+    chMtxUnlock(&i2c_bus_mutex);
+    return status;
+}
+#else
+static inline void i2c_bus_lock(void) {}
+
+static inline i2c_status_t i2c_bus_unlock(i2c_status_t status) {
+    return status;
+}
+#endif
+
 __attribute__((weak)) void i2c_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -149,18 +169,21 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_bus_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_bus_unlock(i2c_epilogue(status));
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_bus_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (address >> 1), data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_bus_unlock(i2c_epilogue(status));
 }
 
 i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_bus_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 1];
@@ -170,10 +193,11 @@ i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t*
     complete_packet[0] = regaddr;
 
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_bus_unlock(i2c_epilogue(status));
 }
 
 i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_bus_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 2];
@@ -184,20 +208,22 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
     complete_packet[1] = regaddr & 0xFF;
 
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), complete_packet, length + 2, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_bus_unlock(i2c_epilogue(status));
 }
 
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_bus_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_bus_unlock(i2c_epilogue(status));
 }
 
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_bus_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_bus_unlock(i2c_epilogue(status));
 }
 
 __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
@@ -207,3 +233,74 @@ __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t ti
     uint8_t data = 0;
     return i2c_read_register(address, 0, &data, sizeof(data), timeout);
 }
+
+#ifdef I2C_ASYNC_ENABLE
+static const i2c_async_transfer_t* async_transfers;
+static uint8_t                     async_count;
+static uint16_t                    async_timeout;
+static i2c_async_callback_t        async_callback;
+static volatile bool               async_busy = false;
+static BSEMAPHORE_DECL(async_start, true);
+
+/**
+ * @brief Sends the queued chains. The thread sleeps while each transfer is
+ * clocked out by the I2C peripheral, so the main loop keeps running.
+ */
+static THD_WORKING_AREA(waI2cAsyncThread, 256);
+static THD_FUNCTION(I2cAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chBSemWait(&async_start);
+
+        i2c_status_t result = I2C_STATUS_SUCCESS;
+        i2c_bus_lock();
+        for (uint8_t i = 0; i < async_count; i++) {
+            // Keep going after a failure, later transfers may target other devices.
+            i2cStart(&I2C_DRIVER, &i2cconfig);
+            msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (async_transfers[i].address >> 1), async_transfers[i].data, async_transfers[i].length, 0, 0, TIME_MS2I(async_timeout));
+            if (status != MSG_OK) {
+                result = i2c_epilogue(status);
+            }
+        }
+        i2c_bus_unlock(result);
+
+        async_busy = false;
+        if (async_callback) {
+            async_callback(result);
+        }
+    }
+}
+
+i2c_status_t i2c_transmit_chain_async(const i2c_async_transfer_t* transfers, uint8_t count, uint16_t timeout, i2c_async_callback_t callback) {
+    static bool thread_started = false;
+    if (!thread_started) {
+        thread_started = true;
+        chThdCreateStatic(waI2cAsyncThread, sizeof(waI2cAsyncThread), NORMALPRIO + 1, I2cAsyncThread, NULL);
+    }
+
+    if (async_busy) {
+        return I2C_STATUS_ERROR;
+    }
+
+    async_transfers = transfers;
+    async_count     = count;
+    async_timeout   = timeout;
+    async_callback  = callback;
+    async_busy      = true;
+    chBSemSignal(&async_start);
+
+    return I2C_STATUS_SUCCESS;
+}
+
+bool i2c_async_busy(void) {
+    return async_busy;
+}
+
+void i2c_async_wait(void) {
+    while (async_busy) {
+        chThdSleepMilliseconds(1);
+    }
+}
+#endif
@@ -60,8 +60,6 @@ static inline bool react_to_transaction(void) {
         return false;
     }
 
-    split_shared_memory_lock_autounlock();
-
     split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
 
     /* Send back the handshake which is XORed as a simple checksum,
@@ -100,6 +98,10 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+    /* Held for the whole transaction, clear included, as the split transport
+     * thread may start one of its own while another is waiting for its reply. */
+    split_shared_memory_lock_autounlock();
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
@@ -117,8 +119,6 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
         return false;
     }
 
-    split_shared_memory_lock_autounlock();
-
     split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
 
     /* Send transaction table index to the slave, which doubles as basic handshake token. */
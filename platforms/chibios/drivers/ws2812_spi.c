@@ -112,55 +112,77 @@
 #define DATA_SIZE (BYTES_FOR_LED * WS2812_LED_COUNT)
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
+#define TXBUF_SIZE (PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE)
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// The next frame is encoded into one buffer while the other one is still being sent.
+// The circular buffer is sent continuously and synchronous sends are done when the flush returns,
+// so those only need the one.
+#if defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC)
+#    define TXBUF_COUNT 1
+#else
+#    define TXBUF_COUNT 2
+#endif
+
+// Word aligned, so that every byte of an LED is encoded with a single store.
+static uint32_t txbuf[TXBUF_COUNT][(TXBUF_SIZE + 3) / 4] = {0};
+static uint8_t  txbuf_index                              = 0;
+
+#if !defined(WS2812_SPI_USE_CIRCULAR_BUFFER) && !defined(WS2812_SPI_SYNC)
+// Set while a frame is on the wire, cleared by the SPI interrupt once it is out
+static volatile bool      spi_busy    = false;
+static thread_reference_t spi_waiting = NULL;
+
+static void spi_end(SPIDriver* spip) {
+    (void)spip;
+    osalSysLockFromISR();
+    spi_busy = false;
+    osalThreadResumeI(&spi_waiting, MSG_OK);
+    osalSysUnlockFromISR();
+}
+#    define WS2812_SPI_END_CB spi_end
+#else
+#    define WS2812_SPI_END_CB NULL
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, every bit of the LED data is sent as four SPI bits:
+ * 0b1110 for a 1 and 0b1000 for a 0 (with the appropriate timing). The table
+ * below holds the 32 SPI bits for every possible byte, with the first byte
+ * on the wire in the least significant byte of the word.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
-}
+#define WS2812_SPI_NIBBLE(data, bit) ((((data) >> (bit)) & 1) ? 0b1110 : 0b1000)
+#define WS2812_SPI_BYTE(data, pos) ((WS2812_SPI_NIBBLE(data, 7 - 2 * (pos)) << 4) | WS2812_SPI_NIBBLE(data, 6 - 2 * (pos)))
+#define WS2812_SPI_WORD(data) ((uint32_t)WS2812_SPI_BYTE(data, 0) | (uint32_t)WS2812_SPI_BYTE(data, 1) << 8 | (uint32_t)WS2812_SPI_BYTE(data, 2) << 16 | (uint32_t)WS2812_SPI_BYTE(data, 3) << 24)
+#define WS2812_SPI_WORDS_4(n) WS2812_SPI_WORD(n), WS2812_SPI_WORD(n + 1), WS2812_SPI_WORD(n + 2), WS2812_SPI_WORD(n + 3)
+#define WS2812_SPI_WORDS_16(n) WS2812_SPI_WORDS_4(n), WS2812_SPI_WORDS_4(n + 4), WS2812_SPI_WORDS_4(n + 8), WS2812_SPI_WORDS_4(n + 12)
+#define WS2812_SPI_WORDS_64(n) WS2812_SPI_WORDS_16(n), WS2812_SPI_WORDS_16(n + 16), WS2812_SPI_WORDS_16(n + 32), WS2812_SPI_WORDS_16(n + 48)
+
+static const uint32_t protocol_eq[256] = {
+    WS2812_SPI_WORDS_64(0),
+    WS2812_SPI_WORDS_64(64),
+    WS2812_SPI_WORDS_64(128),
+    WS2812_SPI_WORDS_64(192),
+};
 
-static void set_led_color_rgb(ws2812_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+static void set_led_color_rgb(uint32_t* tx, ws2812_led_t color, int pos) {
+    uint32_t* tx_led = &tx[(PREAMBLE_SIZE + BYTES_FOR_LED * pos) / 4];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    tx_led[0] = protocol_eq[color.g];
+    tx_led[1] = protocol_eq[color.r];
+    tx_led[2] = protocol_eq[color.b];
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    tx_led[0] = protocol_eq[color.r];
+    tx_led[1] = protocol_eq[color.g];
+    tx_led[2] = protocol_eq[color.b];
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+    tx_led[0] = protocol_eq[color.b];
+    tx_led[1] = protocol_eq[color.g];
+    tx_led[2] = protocol_eq[color.r];
 #endif
 #ifdef WS2812_RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 3 + j] = get_protocol_eq(color.w, j);
+    tx_led[3] = protocol_eq[color.w];
 #endif
 }
 
@@ -180,7 +202,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_END_CB, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -199,7 +221,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
+        WS2812_SPI_END_CB, // data_cb
         NULL, // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
@@ -220,7 +242,7 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, txbuf[0]);
 #endif
 }
 
@@ -239,18 +261,37 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     }
 }
 
+bool ws2812_flush_pending(void) {
+#if defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC)
+    return false;
+#else
+    return spi_busy;
+#endif
+}
+
 void ws2812_flush(void) {
+    uint32_t* tx = txbuf[txbuf_index];
+
     for (int i = 0; i < WS2812_LED_COUNT; i++) {
-        set_led_color_rgb(ws2812_leds[i], i);
+        set_led_color_rgb(tx, ws2812_leds[i], i);
     }
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
+    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms. The encoding above went into the idle
+    // buffer, but the previous frame has to be on the wire before the next one can start.
+    // Instead spiSend can be used to send synchronously.
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, tx);
 #    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    // Sleeps until the interrupt wakes it, rather than spinning
+    osalSysLock();
+    if (spi_busy) {
+        osalThreadSuspendS(&spi_waiting);
+    }
+    spi_busy = true;
+    osalSysUnlock();
+    spiStartSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, tx);
+    txbuf_index = (txbuf_index + 1) % TXBUF_COUNT;
 #    endif
 #endif
 }
@@ -43,3 +43,15 @@ typedef ioline_t pin_t;
 #define gpio_read_pin(pin) palReadLine(pin)
 
 #define gpio_toggle_pin(pin) palToggleLine(pin)
+
+/* Pin change interrupts, requires PAL_USE_CALLBACKS in halconf.h.
+ * Pins with the same number on different ports share an interrupt line. */
+#if defined(PAL_USE_CALLBACKS) && (PAL_USE_CALLBACKS == TRUE)
+#    define gpio_pin_interrupt_line(pin) PAL_PAD(pin)
+#    define gpio_enable_pin_interrupt(pin, callback)              \
+        do {                                                      \
+            palEnableLineEvent((pin), PAL_EVENT_MODE_BOTH_EDGES); \
+            palSetLineCallback((pin), (callback), NULL);          \
+        } while (0)
+#    define gpio_disable_pin_interrupt(pin) palDisableLineEvent(pin)
+#endif
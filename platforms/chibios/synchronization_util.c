@@ -24,3 +24,38 @@ void split_shared_memory_unlock(void) {
     chMtxUnlock(&SPLIT_SHARED_MEMORY_MUTEX);
 }
 #endif
+
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_TRANSPORT_THREAD)
+#    if !defined(SPLIT_TRANSPORT_THREAD_STACK_SIZE)
+#        define SPLIT_TRANSPORT_THREAD_STACK_SIZE 1024
+#    endif
+
+static void (*volatile split_transport_task)(void) = NULL;
+static BSEMAPHORE_DECL(split_transport_start, true);
+
+/**
+ * @brief This thread runs split transactions on the master. It sleeps while
+ * the USART or I2C driver moves the bytes, so the main loop keeps scanning.
+ */
+static THD_WORKING_AREA(waSplitTransportThread, SPLIT_TRANSPORT_THREAD_STACK_SIZE);
+static THD_FUNCTION(SplitTransportThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_transport");
+
+    while (true) {
+        chBSemWait(&split_transport_start);
+        split_transport_task();
+    }
+}
+
+void split_transport_thread_run(void (*task)(void)) {
+    static bool thread_started = false;
+    if (!thread_started) {
+        thread_started = true;
+        chThdCreateStatic(waSplitTransportThread, sizeof(waSplitTransportThread), NORMALPRIO + 1, SplitTransportThread, NULL);
+    }
+
+    split_transport_task = task;
+    chBSemSignal(&split_transport_start);
+}
+#endif
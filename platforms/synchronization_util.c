@@ -10,6 +10,9 @@
 extern inline void split_shared_memory_lock(void);
 extern inline void split_shared_memory_unlock(void);
 #    endif
+#    if defined(SPLIT_KEYBOARD) && defined(SPLIT_TRANSPORT_THREAD)
+extern inline void split_transport_thread_run(void (*task)(void));
+#    endif
 #endif
 
 #if defined(SPLIT_KEYBOARD)
@@ -8,11 +8,25 @@
 void split_shared_memory_lock(void);
 void split_shared_memory_unlock(void);
 #    endif
+#    if defined(SPLIT_KEYBOARD) && defined(SPLIT_TRANSPORT_THREAD)
+/**
+ * @brief Runs task on the master's split transport thread, starting the thread
+ * the first time. If the thread is still busy with the task from before, it runs
+ * the task again once it is done.
+ */
+void split_transport_thread_run(void (*task)(void));
+#    endif
 #else
 #    if defined(SPLIT_KEYBOARD)
 inline void split_shared_memory_lock(void){};
 inline void split_shared_memory_unlock(void){};
 #    endif
+#    if defined(SPLIT_KEYBOARD) && defined(SPLIT_TRANSPORT_THREAD)
+/* Without threads the task runs in place. */
+inline void split_transport_thread_run(void (*task)(void)) {
+    task();
+}
+#    endif
 #endif
 
 /* GCCs cleanup attribute expects a function with one parameter, which is a
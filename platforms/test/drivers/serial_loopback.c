@@ -0,0 +1,207 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_loopback.h"
+#include "transactions.h"
+#include "transport.h"
+#include "action_layer.h"
+#include "action_util.h"
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif
+
+void advance_time(uint32_t ms);
+
+// What the slave applies from the shared memory, which would otherwise overwrite the master's own
+typedef struct {
+    layer_state_t layer_state;
+    layer_state_t default_layer_state;
+    uint8_t       real_mods;
+    uint8_t       weak_mods;
+#ifndef NO_ACTION_ONESHOT
+    uint8_t oneshot_mods;
+    uint8_t oneshot_locked_mods;
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    rgb_config_t rgb_matrix;
+#endif
+} half_state_t;
+
+static split_shared_memory_t   slave_shmem;
+static half_state_t            slave_state;
+static serial_loopback_stats_t stats;
+static uint32_t                latency;
+static uint32_t                bit_error_rate;
+static uint32_t                bits_to_error;
+static uint8_t                 drop_rate;
+
+// Deterministic xorshift, so impaired runs are reproducible
+static uint32_t seed = 0x12345678;
+
+static uint32_t next_random(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+// Swaps the slave's shared memory in or out, split_shmem itself cannot be repointed
+static void swap_shared_memory(void) {
+    uint8_t *master = (uint8_t *)split_shmem;
+    uint8_t *slave  = (uint8_t *)&slave_shmem;
+    for (size_t i = 0; i < sizeof(split_shared_memory_t); i++) {
+        uint8_t byte = master[i];
+        master[i]    = slave[i];
+        slave[i]     = byte;
+    }
+}
+
+static void swap_half_state(void) {
+    half_state_t master = {
+        .layer_state         = layer_state,
+        .default_layer_state = default_layer_state,
+        .real_mods           = get_mods(),
+        .weak_mods           = get_weak_mods(),
+#ifndef NO_ACTION_ONESHOT
+        .oneshot_mods        = get_oneshot_mods(),
+        .oneshot_locked_mods = get_oneshot_locked_mods(),
+#endif
+#ifdef RGB_MATRIX_ENABLE
+        .rgb_matrix = rgb_matrix_config,
+#endif
+    };
+    layer_state         = slave_state.layer_state;
+    default_layer_state = slave_state.default_layer_state;
+    set_mods(slave_state.real_mods);
+    set_weak_mods(slave_state.weak_mods);
+#ifndef NO_ACTION_ONESHOT
+    // Restarts the one shot timeout when the halves differ
+    set_oneshot_mods(slave_state.oneshot_mods);
+    set_oneshot_locked_mods(slave_state.oneshot_locked_mods);
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    rgb_matrix_config = slave_state.rgb_matrix;
+#endif
+    slave_state = master;
+}
+
+// Switches between the master and the slave, in either direction
+static void swap_halves(void) {
+    swap_shared_memory();
+    swap_half_state();
+}
+
+static void reset_bits_to_error(void) {
+    // Anywhere from 1 to twice the rate, averaging out at the rate
+    bits_to_error = bit_error_rate ? 1 + next_random() % (2 * bit_error_rate) : 0;
+}
+
+static void transfer(uint8_t *destination, const uint8_t *source, size_t length) {
+    memcpy(destination, source, length);
+    stats.bytes += length;
+
+    if (!bit_error_rate) {
+        return;
+    }
+    uint32_t bits = length * 8;
+    uint32_t pos  = 0;
+    while (bits - pos >= bits_to_error) {
+        pos += bits_to_error;
+        destination[(pos - 1) / 8] ^= 1 << ((pos - 1) % 8);
+        stats.bit_errors++;
+        reset_bits_to_error();
+    }
+    bits_to_error -= bits - pos;
+}
+
+void serial_loopback_reset(void) {
+    memset(&slave_shmem, 0, sizeof(slave_shmem));
+    memset(&slave_state, 0, sizeof(slave_state));
+    memset(&stats, 0, sizeof(stats));
+    latency        = 0;
+    bit_error_rate = 0;
+    bits_to_error  = 0;
+    drop_rate      = 0;
+}
+
+void serial_loopback_restart_slave(void) {
+    memset(&slave_shmem, 0, sizeof(slave_shmem));
+    memset(&slave_state, 0, sizeof(slave_state));
+}
+
+void serial_loopback_set_latency(uint32_t ms) {
+    latency = ms;
+}
+
+void serial_loopback_set_bit_error_rate(uint32_t bits) {
+    bit_error_rate = bits;
+    reset_bits_to_error();
+}
+
+void serial_loopback_set_drop_rate(uint8_t percent) {
+    drop_rate = percent;
+}
+
+void serial_loopback_slave_task(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    swap_halves();
+    transport_slave(master_matrix, slave_matrix);
+    swap_halves();
+}
+
+void serial_loopback_get_stats(serial_loopback_stats_t *out) {
+    *out = stats;
+}
+
+const split_shared_memory_t *serial_loopback_slave_shared_memory(void) {
+    return &slave_shmem;
+}
+
+layer_state_t serial_loopback_slave_layer_state(void) {
+    return slave_state.layer_state;
+}
+
+uint8_t serial_loopback_slave_mods(void) {
+    return slave_state.real_mods;
+}
+
+#ifdef RGB_MATRIX_ENABLE
+rgb_config_t serial_loopback_slave_rgb_matrix_config(void) {
+    return slave_state.rgb_matrix;
+}
+#endif
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int sstd_index) {
+    split_transaction_desc_t *trans   = &split_transaction_table[sstd_index];
+    bool                      dropped = drop_rate > 0 && next_random() % 100 < drop_rate;
+    // A lost transaction may have reached the slave, only its reply went missing
+    bool reached = !dropped || next_random() % 2;
+
+    stats.transactions++;
+    advance_time(latency);
+
+    if (reached) {
+        stats.bytes += 2; // transaction ID, and the handshake the slave answers it with
+        transfer((uint8_t *)&slave_shmem + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+
+        swap_halves();
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+        swap_halves();
+    }
+
+    if (dropped) {
+        stats.dropped++;
+        return false;
+    }
+
+    transfer(split_trans_target2initiator_buffer(trans), (uint8_t *)&slave_shmem + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+    return true;
+}
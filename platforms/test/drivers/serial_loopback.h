@@ -0,0 +1,88 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "matrix.h"
+#include "transport.h"
+#include "action_layer.h"
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix_types.h"
+#endif
+
+/*
+    Serial driver for split keyboards on the test platform, linking both halves
+    inside one process.
+
+    The master half uses split_shmem as usual. The slave half's copy of the
+    shared memory is kept here and swapped in while slave code runs, so that
+    transactions.c and transport.c run unchanged on both sides. Each transaction
+    follows the ChibiOS serial protocol: the transaction ID is answered with a
+    handshake, the initiator's buffer is received by the target, its callback
+    runs, and the target's buffer is sent back.
+
+    Each half also has its own layers, modifiers and RGB Matrix config.
+    Everything else the slave applies, such as the sync timer, the activity
+    timestamps or RGB Matrix key hits, ends up in the single copy shared by
+    both halves, so tests should check what crosses the link rather than that
+    state.
+*/
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t dropped;
+    uint32_t bytes;      // both directions, as they would be on the wire
+    uint32_t bit_errors; // bits flipped on the way
+} serial_loopback_stats_t;
+
+/**
+ * \brief Clears the slave's shared memory and state, the statistics and any impairments.
+ */
+void serial_loopback_reset(void);
+
+/**
+ * \brief Clears the slave's shared memory and state, as if it had been power cycled. Impairments are kept.
+ */
+void serial_loopback_restart_slave(void);
+
+/**
+ * \brief Milliseconds every transaction takes, the clock is advanced by this much each time.
+ */
+void serial_loopback_set_latency(uint32_t ms);
+
+/**
+ * \brief Flips one bit every this many bits transferred, on average. 0 disables bit errors.
+ */
+void serial_loopback_set_bit_error_rate(uint32_t bits);
+
+/**
+ * \brief Percentage of transactions that are lost, either before the slave sees them or on the way back.
+ *
+ * 100 simulates a disconnected slave.
+ */
+void serial_loopback_set_drop_rate(uint8_t percent);
+
+/**
+ * \brief Runs one pass of the slave's main loop, against the slave's shared memory.
+ *
+ * \param master_matrix The master's half of the matrix, as the slave sees it.
+ * \param slave_matrix The slave's half of the matrix, as scanned by the slave.
+ */
+void serial_loopback_slave_task(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+
+void serial_loopback_get_stats(serial_loopback_stats_t *stats);
+
+/**
+ * \brief The slave's copy of the shared memory, what it has received so far.
+ */
+const split_shared_memory_t *serial_loopback_slave_shared_memory(void);
+
+layer_state_t serial_loopback_slave_layer_state(void);
+uint8_t       serial_loopback_slave_mods(void);
+
+#ifdef RGB_MATRIX_ENABLE
+rgb_config_t serial_loopback_slave_rgb_matrix_config(void);
+#endif
@@ -0,0 +1,111 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "gpio_mock.h"
+
+static bool                 pin_is_output[GPIO_MOCK_PIN_COUNT];
+static bool                 pin_output_level[GPIO_MOCK_PIN_COUNT];
+static bool                 pin_last_level[GPIO_MOCK_PIN_COUNT];
+static gpio_mock_callback_t pin_callback[GPIO_MOCK_PIN_COUNT];
+static uint8_t              pin_interrupt_line[GPIO_MOCK_PIN_COUNT];
+static bool                 switches[GPIO_MOCK_PIN_COUNT][GPIO_MOCK_PIN_COUNT];
+static uint32_t             read_count;
+static uint32_t             interrupt_count;
+
+static bool pin_level(pin_t pin) {
+    if (pin_is_output[pin]) {
+        return pin_output_level[pin];
+    }
+    for (pin_t output = 0; output < GPIO_MOCK_PIN_COUNT; output++) {
+        if (switches[pin][output] && pin_is_output[output] && !pin_output_level[output]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Fires the callback of every armed pin whose level changed since it was last looked at */
+static void update_interrupts(void) {
+    for (pin_t pin = 0; pin < GPIO_MOCK_PIN_COUNT; pin++) {
+        bool level = pin_level(pin);
+        if (level != pin_last_level[pin]) {
+            pin_last_level[pin] = level;
+            if (pin_callback[pin]) {
+                interrupt_count++;
+                pin_callback[pin](NULL);
+            }
+        }
+    }
+}
+
+void gpio_mock_set_pin_input(pin_t pin) {
+    pin_is_output[pin] = false;
+    update_interrupts();
+}
+
+void gpio_mock_set_pin_output(pin_t pin) {
+    pin_is_output[pin] = true;
+    update_interrupts();
+}
+
+void gpio_mock_write_pin(pin_t pin, bool level) {
+    pin_output_level[pin] = level;
+    update_interrupts();
+}
+
+bool gpio_mock_read_pin(pin_t pin) {
+    read_count++;
+    return pin_level(pin);
+}
+
+void gpio_mock_enable_pin_interrupt(pin_t pin, gpio_mock_callback_t callback) {
+    pin_last_level[pin] = pin_level(pin);
+    pin_callback[pin]   = callback;
+}
+
+void gpio_mock_disable_pin_interrupt(pin_t pin) {
+    pin_callback[pin] = NULL;
+}
+
+uint8_t gpio_mock_pin_interrupt_line(pin_t pin) {
+    return pin_interrupt_line[pin];
+}
+
+void gpio_mock_reset(void) {
+    memset(pin_is_output, 0, sizeof(pin_is_output));
+    memset(pin_output_level, 0, sizeof(pin_output_level));
+    memset(pin_callback, 0, sizeof(pin_callback));
+    memset(switches, 0, sizeof(switches));
+    for (pin_t pin = 0; pin < GPIO_MOCK_PIN_COUNT; pin++) {
+        pin_last_level[pin]     = true;
+        pin_interrupt_line[pin] = pin;
+    }
+    read_count      = 0;
+    interrupt_count = 0;
+}
+
+void gpio_mock_set_switch(pin_t input, pin_t output, bool closed) {
+    switches[input][output] = closed;
+    update_interrupts();
+}
+
+bool gpio_mock_is_output(pin_t pin) {
+    return pin_is_output[pin];
+}
+
+bool gpio_mock_interrupt_enabled(pin_t pin) {
+    return pin_callback[pin] != NULL;
+}
+
+uint32_t gpio_mock_read_count(void) {
+    return read_count;
+}
+
+uint32_t gpio_mock_interrupt_count(void) {
+    return interrupt_count;
+}
+
+void gpio_mock_set_interrupt_line(pin_t pin, uint8_t line) {
+    pin_interrupt_line[pin] = line;
+}
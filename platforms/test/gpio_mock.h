@@ -0,0 +1,55 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Simulated GPIO bank for host side tests of code driving pins directly.
+ *
+ * Inputs read high through their pull-up unless a closed switch connects them
+ * to an output that is driven low. Switches conduct in one direction only, as
+ * if every one of them had a diode, so simulated matrices never ghost. */
+
+typedef uint8_t pin_t;
+
+#define GPIO_MOCK_PIN_COUNT 32
+
+#define gpio_set_pin_input(pin) gpio_mock_set_pin_input(pin)
+#define gpio_set_pin_input_high(pin) gpio_mock_set_pin_input(pin)
+#define gpio_set_pin_input_low(pin) gpio_mock_set_pin_input(pin)
+#define gpio_set_pin_output_push_pull(pin) gpio_mock_set_pin_output(pin)
+#define gpio_set_pin_output_open_drain(pin) gpio_mock_set_pin_output(pin)
+#define gpio_set_pin_output(pin) gpio_mock_set_pin_output(pin)
+
+#define gpio_write_pin_high(pin) gpio_mock_write_pin(pin, true)
+#define gpio_write_pin_low(pin) gpio_mock_write_pin(pin, false)
+#define gpio_write_pin(pin, level) gpio_mock_write_pin(pin, level)
+
+#define gpio_read_pin(pin) gpio_mock_read_pin(pin)
+
+#define gpio_toggle_pin(pin) gpio_mock_write_pin(pin, !gpio_mock_read_pin(pin))
+
+#define gpio_enable_pin_interrupt(pin, callback) gpio_mock_enable_pin_interrupt(pin, callback)
+#define gpio_disable_pin_interrupt(pin) gpio_mock_disable_pin_interrupt(pin)
+#define gpio_pin_interrupt_line(pin) gpio_mock_pin_interrupt_line(pin)
+
+typedef void (*gpio_mock_callback_t)(void *arg);
+
+void gpio_mock_set_pin_input(pin_t pin);
+void gpio_mock_set_pin_output(pin_t pin);
+void gpio_mock_write_pin(pin_t pin, bool level);
+bool gpio_mock_read_pin(pin_t pin);
+void gpio_mock_enable_pin_interrupt(pin_t pin, gpio_mock_callback_t callback);
+void gpio_mock_disable_pin_interrupt(pin_t pin);
+uint8_t gpio_mock_pin_interrupt_line(pin_t pin);
+
+/* Test controls */
+void     gpio_mock_reset(void);
+void     gpio_mock_set_switch(pin_t input, pin_t output, bool closed);
+bool     gpio_mock_is_output(pin_t pin);
+bool     gpio_mock_interrupt_enabled(pin_t pin);
+uint32_t gpio_mock_read_count(void);
+uint32_t gpio_mock_interrupt_count(void);
+void     gpio_mock_set_interrupt_line(pin_t pin, uint8_t line); // each pin has a line of its own until changed
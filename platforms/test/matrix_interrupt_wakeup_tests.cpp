@@ -0,0 +1,171 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+extern "C" {
+#include "matrix.h"
+#include "timer.h"
+#include "gpio_mock.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct MatrixEvent {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+class MatrixInterruptWakeup : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        gpio_mock_reset();
+        set_time(0);
+        matrix_init();
+    }
+
+    void set_key(uint8_t row, uint8_t col, bool pressed) {
+        /* COL2ROW: the column input is pulled low through the selected row */
+        gpio_mock_set_switch(4 + col, row, pressed);
+    }
+
+    /* Runs one scan per millisecond, recording every debounced transition */
+    void scan_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            matrix_scan();
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                matrix_row_t changes = matrix_get_row(row) ^ previous_[row];
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    if (changes & ((matrix_row_t)1 << col)) {
+                        events_.push_back({timer_read32(), row, col, matrix_is_on(row, col)});
+                    }
+                }
+                previous_[row] = matrix_get_row(row);
+            }
+            advance_time(1);
+        }
+    }
+
+    std::vector<MatrixEvent> events_;
+    matrix_row_t             previous_[MATRIX_ROWS] = {0};
+};
+
+TEST_F(MatrixInterruptWakeup, GoesIdleWithoutKeys) {
+    scan_for(DEBOUNCE + 2);
+    EXPECT_TRUE(matrix_is_idle());
+
+    for (pin_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_TRUE(gpio_mock_is_output(row));
+    }
+    for (pin_t col = 4; col < 4 + MATRIX_COLS; col++) {
+        EXPECT_TRUE(gpio_mock_interrupt_enabled(col));
+    }
+
+    /* No pins are read while idle */
+    uint32_t reads = gpio_mock_read_count();
+    scan_for(100);
+    EXPECT_EQ(gpio_mock_read_count(), reads);
+    EXPECT_TRUE(events_.empty());
+}
+
+TEST_F(MatrixInterruptWakeup, PressWakesUp) {
+    scan_for(DEBOUNCE + 2);
+    ASSERT_TRUE(matrix_is_idle());
+
+    set_key(2, 3, true);
+    EXPECT_GT(gpio_mock_interrupt_count(), 0u);
+    scan_for(1);
+    EXPECT_FALSE(matrix_is_idle());
+    for (pin_t col = 4; col < 4 + MATRIX_COLS; col++) {
+        EXPECT_FALSE(gpio_mock_interrupt_enabled(col));
+    }
+
+    scan_for(DEBOUNCE + 1);
+    EXPECT_TRUE(matrix_is_on(2, 3));
+
+    /* Stays awake while the key is held */
+    scan_for(100);
+    EXPECT_FALSE(matrix_is_idle());
+
+    set_key(2, 3, false);
+    scan_for(DEBOUNCE + 1);
+    EXPECT_FALSE(matrix_is_on(2, 3));
+    scan_for(DEBOUNCE + 2);
+    EXPECT_TRUE(matrix_is_idle());
+
+    ASSERT_EQ(events_.size(), 2u);
+    EXPECT_TRUE(events_[0].pressed);
+    EXPECT_FALSE(events_[1].pressed);
+}
+
+TEST_F(MatrixInterruptWakeup, PressBeforeIdleIsNotLost) {
+    /* Key goes down in the same millisecond the matrix decides to go idle */
+    scan_for(DEBOUNCE + 1);
+    ASSERT_FALSE(matrix_is_idle());
+    set_key(0, 0, true);
+    scan_for(1);
+    scan_for(DEBOUNCE + 2);
+    EXPECT_TRUE(matrix_is_on(0, 0));
+}
+
+TEST_F(MatrixInterruptWakeup, NoEventsLost) {
+    /* Pseudo random sequence of presses and releases, each state held longer than DEBOUNCE */
+    std::vector<MatrixEvent> expected;
+    bool                     state[MATRIX_ROWS][MATRIX_COLS] = {{false}};
+    uint32_t                 seed                            = 0xC0FFEE;
+
+    scan_for(DEBOUNCE + 2);
+    for (int i = 0; i < 300; i++) {
+        seed        = seed * 1103515245 + 12345;
+        uint8_t row = (seed >> 16) % MATRIX_ROWS;
+        uint8_t col = (seed >> 20) % MATRIX_COLS;
+        uint8_t gap = (seed >> 24) % 40;
+
+        state[row][col] = !state[row][col];
+        set_key(row, col, state[row][col]);
+        expected.push_back({0, row, col, state[row][col]});
+        scan_for(DEBOUNCE + 2 + gap);
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (state[row][col]) {
+                set_key(row, col, false);
+                expected.push_back({0, row, col, false});
+                scan_for(DEBOUNCE + 2);
+            }
+        }
+    }
+    scan_for(DEBOUNCE + 2);
+    EXPECT_TRUE(matrix_is_idle());
+
+    ASSERT_EQ(events_.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(events_[i].row, expected[i].row) << "event " << i;
+        EXPECT_EQ(events_[i].col, expected[i].col) << "event " << i;
+        EXPECT_EQ(events_[i].pressed, expected[i].pressed) << "event " << i;
+    }
+}
+
+TEST_F(MatrixInterruptWakeup, SharedInterruptLineFallsBackToPolling) {
+    /* As with A0 and B0 on STM32 */
+    gpio_mock_set_interrupt_line(5, 4);
+    matrix_init();
+
+    scan_for(DEBOUNCE + 2);
+    ASSERT_TRUE(matrix_is_idle());
+    for (pin_t col = 4; col < 4 + MATRIX_COLS; col++) {
+        EXPECT_FALSE(gpio_mock_interrupt_enabled(col));
+    }
+
+    set_key(1, 1, true);
+    scan_for(1);
+    EXPECT_FALSE(matrix_is_idle());
+    scan_for(DEBOUNCE + 1);
+    EXPECT_TRUE(matrix_is_on(1, 1));
+    EXPECT_EQ(gpio_mock_interrupt_count(), 0u);
+}
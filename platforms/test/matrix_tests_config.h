@@ -0,0 +1,24 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 4
+
+/* Pins 0-3 are rows, 4-7 are columns */
+#define MATRIX_ROW_PINS {0, 1, 2, 3}
+#define MATRIX_COL_PINS {4, 5, 6, 7}
+#define DIODE_DIRECTION COL2ROW
+
+#define DEBOUNCE 5
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gpio_mock.h"
+
+#ifdef __cplusplus
+};
+#endif
@@ -23,3 +23,14 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+matrix_interrupt_wakeup_DEFS := -DMATRIX_INTERRUPT_WAKEUP -DIGNORE_ATOMIC_BLOCK -DNO_PRINT
+matrix_interrupt_wakeup_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_tests_config.h
+matrix_interrupt_wakeup_SRC := \
+	$(QUANTUM_PATH)/matrix.c \
+	$(QUANTUM_PATH)/matrix_common.c \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/gpio_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_interrupt_wakeup_tests.cpp
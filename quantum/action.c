@@ -31,6 +31,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "keycode_config.h"
 #include "debug.h"
 #include "quantum.h"
+#include "task_deadline.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -59,6 +60,10 @@ uint8_t retro_tap_next_mods = 0;
 #    include "process_auto_shift.h"
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifdef HOLD_ON_OTHER_KEY_PRESS_PER_KEY
 __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record) {
     return false;
@@ -81,6 +86,7 @@ void action_exec(keyevent_t event) {
         ac_dprintf("EVENT: ");
         debug_event(event);
         ac_dprintf("\n");
+        task_deadline_wake_all();
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY) || (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
         uint16_t event_keycode = get_event_keycode(event, false);
         if (event.pressed) {
@@ -145,6 +151,34 @@ void action_exec(keyevent_t event) {
 #endif
 }
 
+/** \brief Checks whether a tick event would have anything to do
+ *
+ * Ticks settle tap-hold keys and time out one-shot keys. Without either pending
+ * they are skipped entirely.
+ */
+bool action_tick_pending(void) {
+#ifndef NO_ACTION_ONESHOT
+#    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+    if (keymap_config.oneshot_enable) {
+        if (has_oneshot_layer_timed_out() || has_oneshot_mods_timed_out()) {
+            return true;
+        }
+#        ifdef SWAP_HANDS_ENABLE
+        if (has_oneshot_swaphands_timed_out()) {
+            return true;
+        }
+#        endif
+    }
+#    endif
+#endif
+
+#ifndef NO_ACTION_TAPPING
+    return action_tapping_pending();
+#else
+    return false;
+#endif
+}
+
 #ifdef SWAP_HANDS_ENABLE
 extern const keypos_t PROGMEM hand_swap_config[MATRIX_ROWS][MATRIX_COLS];
 #    ifdef ENCODER_MAP_ENABLE
@@ -281,9 +315,14 @@ void process_record(keyrecord_t *record) {
     if (IS_NOEVENT(record->event)) {
         return;
     }
+    // Buffered events may be processed long after action_exec(), wake timeout tasks again
+    task_deadline_wake_all();
 #ifdef FLOW_TAP_TERM
     flow_tap_update_last_event(record);
 #endif // FLOW_TAP_TERM
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_begin(&record->event);
+#endif
 
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
@@ -291,11 +330,14 @@ void process_record(keyrecord_t *record) {
             clear_oneshot_layer_state(ONESHOT_OTHER_KEY_PRESSED);
         }
 #endif
-        return;
+    } else {
+        process_record_handler(record);
+        post_process_record_quantum(record);
     }
 
-    process_record_handler(record);
-    post_process_record_quantum(record);
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_end();
+#endif
 }
 
 void process_record_handler(keyrecord_t *record) {
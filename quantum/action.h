@@ -58,6 +58,9 @@ typedef struct keyrecord_t {
 /* Execute action per keyevent */
 void action_exec(keyevent_t event);
 
+/* True if a tick event may change state, i.e. a tap-hold decision or timeout is pending */
+bool action_tick_pending(void);
+
 /* action for key */
 action_t action_for_key(uint8_t layer, keypos_t key);
 action_t action_for_keycode(uint16_t keycode);
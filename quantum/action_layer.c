@@ -7,6 +7,10 @@
 #include "util.h"
 #include "action_layer.h"
 
+#ifdef LAYER_CACHE_ENABLE
+#    include "layer_cache.h"
+#endif
+
 /** \brief Default Layer State
  */
 layer_state_t default_layer_state = 0;
@@ -48,6 +52,9 @@ static void default_layer_state_set(layer_state_t state) {
     default_layer_state = state;
     default_layer_debug();
     ac_dprintf("\n");
+#if defined(LAYER_CACHE_ENABLE) && !defined(NO_ACTION_LAYER)
+    layer_cache_update();
+#endif
 #if defined(STRICT_LAYER_RELEASE)
     clear_keyboard_but_mods(); // To avoid stuck keys
 #elif defined(SEMI_STRICT_LAYER_RELEASE)
@@ -138,6 +145,9 @@ void layer_state_set(layer_state_t state) {
     layer_state = state;
     layer_debug();
     ac_dprintf("\n");
+#    ifdef LAYER_CACHE_ENABLE
+    layer_cache_update();
+#    endif
 #    if defined(STRICT_LAYER_RELEASE)
     clear_keyboard_but_mods(); // To avoid stuck keys
 #    elif defined(SEMI_STRICT_LAYER_RELEASE)
@@ -341,6 +351,12 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
  */
 uint8_t layer_switch_get_layer(keypos_t key) {
 #ifndef NO_ACTION_LAYER
+#    ifdef LAYER_CACHE_ENABLE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return layer_cache_get_layer(key);
+    }
+#    endif
+
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
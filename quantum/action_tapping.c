@@ -1,11 +1,13 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "quantum_keycodes.h"
 #include "timer.h"
 
@@ -56,6 +58,8 @@ __attribute__((weak)) bool get_permissive_hold(uint16_t keycode, keyrecord_t *re
 // Array of tap-hold keys that have been settled as tapped but not yet released.
 static keypos_t registered_taps[REGISTERED_TAPS_SIZE] = {};
 static uint8_t  num_registered_taps                   = 0;
+// Matrix keys present in registered_taps, so most releases are looked up without a scan.
+static matrix_row_t registered_taps_keys[MATRIX_ROWS] = {};
 
 /** Adds `key` to the registered_taps array. */
 static void registered_taps_add(keypos_t key);
@@ -115,9 +119,20 @@ static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+// Matrix keys with a buffered press or release, kept in step with the buffer
+// so lookups by key don't need to walk it.
+static matrix_row_t waiting_buffer_presses[MATRIX_ROWS]  = {};
+static matrix_row_t waiting_buffer_releases[MATRIX_ROWS] = {};
+// Number of buffered events whose key and direction were already buffered.
+static uint8_t waiting_buffer_repeats = 0;
+// Number of buffered presses.
+static uint8_t waiting_buffer_pressed = 0;
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_pop(void);
 static void waiting_buffer_clear(void);
+static bool waiting_buffer_contains(keypos_t key, bool pressed);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
@@ -149,7 +164,7 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_pop()) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
@@ -169,6 +184,23 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+/** \brief Checks whether the tapping state machine is waiting on a tick
+ *
+ * True while a tap-hold key is unsettled, events are buffered, or Flow Tap has
+ * not yet expired.
+ */
+bool action_tapping_pending(void) {
+    if (IS_EVENT(tapping_key.event) || waiting_buffer_tail != waiting_buffer_head) {
+        return true;
+    }
+#    ifdef FLOW_TAP_TERM
+    if (!flow_tap_expired) {
+        return true;
+    }
+#    endif // FLOW_TAP_TERM
+    return false;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
@@ -293,7 +325,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     // Now that tapping_key has settled as tapped, check whether
                     // Flow Tap applies to following yet-unsettled keys.
                     uint16_t prev_time = tapping_key.event.time;
-                    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+                    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_pop()) {
                         keyrecord_t *record = &waiting_buffer[waiting_buffer_tail];
                         if (!record->event.pressed) {
                             break;
@@ -353,7 +385,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     uint8_t first_tap = waiting_buffer_find_chordal_hold_tap();
                     ac_dprintf("first_tap = %u\n", first_tap);
                     if (first_tap < WAITING_BUFFER_SIZE) {
-                        for (; waiting_buffer_tail != first_tap; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+                        for (; waiting_buffer_tail != first_tap; waiting_buffer_pop()) {
                             ac_dprintf("Processing [%u]\n", waiting_buffer_tail);
                             process_record(&waiting_buffer[waiting_buffer_tail]);
                         }
@@ -453,7 +485,7 @@ bool process_tapping(keyrecord_t *keyp) {
                             if (waiting_buffer_tail != waiting_buffer_head && is_tap_record(&waiting_buffer[waiting_buffer_tail])) {
                                 tapping_key = waiting_buffer[waiting_buffer_tail];
                                 // Pop tail from the queue.
-                                waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+                                waiting_buffer_pop();
                                 debug_waiting_buffer();
                             } else
 #    endif // CHORDAL_HOLD
@@ -620,6 +652,28 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+/** \brief Returns the row of the waiting buffer key index that tracks `key`
+ * in the given direction, or NULL if `key` is outside the matrix.
+ */
+static matrix_row_t *waiting_buffer_keys(keypos_t key, bool pressed) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return NULL;
+    }
+    return pressed ? &waiting_buffer_presses[key.row] : &waiting_buffer_releases[key.row];
+}
+
+/** \brief Returns true if an event for `key` in the given direction is
+ * buffered at or after index `from`.
+ */
+static bool waiting_buffer_scan_key(uint8_t from, keypos_t key, bool pressed) {
+    for (uint8_t i = from; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+        if (KEYEQ(key, waiting_buffer[i].event.key) && pressed == waiting_buffer[i].event.pressed) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /** \brief Waiting buffer enq
  *
  * FIXME: Needs docs
@@ -637,6 +691,18 @@ bool waiting_buffer_enq(keyrecord_t record) {
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
 
+    if (record.event.pressed) {
+        waiting_buffer_pressed++;
+    }
+    matrix_row_t *keys = waiting_buffer_keys(record.event.key, record.event.pressed);
+    if (keys) {
+        if (*keys & (MATRIX_ROW_SHIFTER << record.event.key.col)) {
+            waiting_buffer_repeats++;
+        } else {
+            *keys |= MATRIX_ROW_SHIFTER << record.event.key.col;
+        }
+    }
+
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
@@ -647,21 +713,51 @@ bool waiting_buffer_enq(keyrecord_t record) {
  * FIXME: Needs docs
  */
 void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+    waiting_buffer_head    = 0;
+    waiting_buffer_tail    = 0;
+    waiting_buffer_repeats = 0;
+    waiting_buffer_pressed = 0;
+    memset(waiting_buffer_presses, 0, sizeof(waiting_buffer_presses));
+    memset(waiting_buffer_releases, 0, sizeof(waiting_buffer_releases));
 }
 
-/** \brief Waiting buffer typed
+/** \brief Waiting buffer pop
  *
- * FIXME: Needs docs
+ * Removes the event at the tail of the buffer, once it has been processed.
  */
-bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
-            return true;
+void waiting_buffer_pop(void) {
+    const keyevent_t event = waiting_buffer[waiting_buffer_tail].event;
+    waiting_buffer_tail    = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+
+    if (event.pressed) {
+        waiting_buffer_pressed--;
+    }
+    matrix_row_t *keys = waiting_buffer_keys(event.key, event.pressed);
+    if (keys) {
+        // Only scan when the same key and direction may still be buffered.
+        if (waiting_buffer_repeats && waiting_buffer_scan_key(waiting_buffer_tail, event.key, event.pressed)) {
+            waiting_buffer_repeats--;
+        } else {
+            *keys &= ~(MATRIX_ROW_SHIFTER << event.key.col);
         }
     }
-    return false;
+}
+
+/** \brief Returns true if an event for `key` in the given direction is buffered. */
+bool waiting_buffer_contains(keypos_t key, bool pressed) {
+    matrix_row_t *keys = waiting_buffer_keys(key, pressed);
+    if (keys) {
+        return *keys & (MATRIX_ROW_SHIFTER << key.col);
+    }
+    return waiting_buffer_scan_key(waiting_buffer_tail, key, pressed);
+}
+
+/** \brief Waiting buffer typed
+ *
+ * Returns true if the buffer holds the opposite transition of `event`'s key.
+ */
+bool waiting_buffer_typed(keyevent_t event) {
+    return waiting_buffer_contains(event.key, !event.pressed);
 }
 
 /** \brief Waiting buffer has anykey pressed
@@ -669,10 +765,7 @@ bool waiting_buffer_typed(keyevent_t event) {
  * FIXME: Needs docs
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
-    }
-    return false;
+    return waiting_buffer_pressed > 0;
 }
 
 /** \brief Scan buffer for tapping
@@ -686,6 +779,10 @@ void waiting_buffer_scan_tap(void) {
     if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed) {
         return;
     }
+    // - the tapping key has no buffered release
+    if (!waiting_buffer_contains(tapping_key.event.key, false)) {
+        return;
+    }
 
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
@@ -714,13 +811,20 @@ static void registered_taps_add(keypos_t key) {
         ac_dprintf("TAPS OVERFLOW: CLEAR ALL STATES\n");
         clear_keyboard();
         num_registered_taps = 0;
+        memset(registered_taps_keys, 0, sizeof(registered_taps_keys));
     }
 
     registered_taps[num_registered_taps] = key;
     ++num_registered_taps;
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        registered_taps_keys[key.row] |= MATRIX_ROW_SHIFTER << key.col;
+    }
 }
 
 static int8_t registered_tap_find(keypos_t key) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS && !(registered_taps_keys[key.row] & (MATRIX_ROW_SHIFTER << key.col))) {
+        return -1;
+    }
     for (int8_t i = 0; i < num_registered_taps; ++i) {
         if (KEYEQ(registered_taps[i], key)) {
             return i;
@@ -731,10 +835,19 @@ static int8_t registered_tap_find(keypos_t key) {
 
 static void registered_taps_del_index(uint8_t i) {
     if (i < num_registered_taps) {
+        const keypos_t key = registered_taps[i];
         --num_registered_taps;
         if (i < num_registered_taps) {
             registered_taps[i] = registered_taps[num_registered_taps];
         }
+        if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+            for (uint8_t j = 0; j < num_registered_taps; ++j) {
+                if (KEYEQ(registered_taps[j], key)) {
+                    return;
+                }
+            }
+            registered_taps_keys[key.row] &= ~(MATRIX_ROW_SHIFTER << key.col);
+        }
     }
 }
 
@@ -797,7 +910,7 @@ static void waiting_buffer_chordal_hold_taps_until(keypos_t key) {
             registered_taps_add(record->event.key);
         }
         process_record(record);
-        waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+        waiting_buffer_pop();
 
         if (KEYEQ(key, record->event.key) && record->event.pressed) {
             break;
@@ -806,7 +919,7 @@ static void waiting_buffer_chordal_hold_taps_until(keypos_t key) {
 }
 
 static void waiting_buffer_process_regular(void) {
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_pop()) {
         if (is_tap_record(&waiting_buffer[waiting_buffer_tail])) {
             break; // Stop once a tap-hold key event is reached.
         }
@@ -21,14 +21,52 @@
         });
 */
 
+#include <stdint.h>
+#include "timer.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+/*
+    Free running timestamps for code keeping its own statistics. Only the difference
+    between two readings is meaningful; convert it with PROFILE_TIMESTAMP_TO_US().
+*/
+
 #if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
+#    include <avr/io.h>
+#    include "atomic_util.h"
+#    include "timer_avr.h"
 #    define TIMESTAMP_GETTER TCNT0
-#elif defined(PROTOCOL_CHIBIOS)
+// Timer0 wraps every millisecond, so combine it with the millisecond counter
+static inline uint32_t profile_timestamp(void) {
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK_RESTORESTATE {
+        ms  = timer_read32();
+        raw = TIMER_RAW;
+        // Wrapped before the read, but the millisecond has not been counted yet
+        if (TIMER_RAW_PENDING && raw < TIMER_RAW_TOP / 2) {
+            ms++;
+        }
+    }
+    return ms * TIMER_RAW_TOP + raw;
+}
+#    define PROFILE_TIMESTAMP() profile_timestamp()
+#    define PROFILE_TIMESTAMP_TO_US(ticks) ((uint32_t)(ticks) * 1000 / TIMER_RAW_TOP)
+#elif defined(PROTOCOL_CHIBIOS) && PORT_SUPPORTS_RT == TRUE
 #    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
+#    define PROFILE_TIMESTAMP() ((uint32_t)chSysGetRealtimeCounterX())
+#    define PROFILE_TIMESTAMP_TO_US(ticks) ((uint32_t)(ticks) / (REALTIME_COUNTER_CLOCK / 1000000UL))
 #else
-#    error Unknown protocol in use
+// Fall back to millisecond resolution, e.g. on the test platform or on cores without a cycle counter (ARMv6-M)
+#    define TIMESTAMP_GETTER timer_read32()
+#    define PROFILE_TIMESTAMP() timer_read32()
+#    define PROFILE_TIMESTAMP_TO_US(ticks) ((uint32_t)(ticks) * 1000)
 #endif
 
+#define PROFILE_ELAPSED_US(start) PROFILE_TIMESTAMP_TO_US((uint32_t)(PROFILE_TIMESTAMP() - (start)))
+
 #ifndef CONSOLE_ENABLE
 // Can't do anything if we don't have console output enabled.
 #    define PROFILE_CALL_NAMED(count, name, call) \
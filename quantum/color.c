@@ -19,84 +19,60 @@
 #include "progmem.h"
 #include "util.h"
 
-rgb_t hsv_to_rgb_impl(hsv_t hsv, bool use_cie) {
-    rgb_t    rgb;
-    uint8_t  region, remainder, p, q, t;
-    uint16_t h, s, v;
+// Channel order of each hue region as indexes into {v, t, p, q}, two bits per channel
+#define HSV_REGION(r, g, b) ((r) | (g) << 2 | (b) << 4)
 
-    if (hsv.s == 0) {
-#ifdef USE_CIE1931_CURVE
-        if (use_cie) {
-            rgb.r = rgb.g = rgb.b = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-        } else {
-            rgb.r = hsv.v;
-            rgb.g = hsv.v;
-            rgb.b = hsv.v;
-        }
-#else
-        rgb.r = hsv.v;
-        rgb.g = hsv.v;
-        rgb.b = hsv.v;
-#endif
-        return rgb;
-    }
+static const uint8_t hsv_regions[7] = {
+    HSV_REGION(0, 1, 2), // v, t, p
+    HSV_REGION(3, 0, 2), // q, v, p
+    HSV_REGION(2, 0, 1), // p, v, t
+    HSV_REGION(2, 3, 0), // p, q, v
+    HSV_REGION(1, 2, 0), // t, p, v
+    HSV_REGION(0, 2, 3), // v, p, q
+    HSV_REGION(0, 1, 2), // hue 255 wraps around to the first region
+};
 
-    h = hsv.h;
-    s = hsv.s;
+static inline uint8_t hsv_value(uint8_t v, bool use_cie) {
 #ifdef USE_CIE1931_CURVE
     if (use_cie) {
-        v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-    } else {
-        v = hsv.v;
+        return pgm_read_byte(&CIE1931_CURVE[v]);
     }
-#else
-    v = hsv.v;
 #endif
+    return v;
+}
 
-    region    = h * 6 / 255;
-    remainder = (h * 2 - region * 85) * 3;
-
-    p = (v * (255 - s)) >> 8;
-    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
-    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+static inline rgb_t hsv_to_rgb_fixed(uint8_t h, uint8_t s, uint8_t v) {
+    rgb_t rgb;
 
-    switch (region) {
-        case 6:
-        case 0:
-            rgb.r = v;
-            rgb.g = t;
-            rgb.b = p;
-            break;
-        case 1:
-            rgb.r = q;
-            rgb.g = v;
-            rgb.b = p;
-            break;
-        case 2:
-            rgb.r = p;
-            rgb.g = v;
-            rgb.b = t;
-            break;
-        case 3:
-            rgb.r = p;
-            rgb.g = q;
-            rgb.b = v;
-            break;
-        case 4:
-            rgb.r = t;
-            rgb.g = p;
-            rgb.b = v;
-            break;
-        default:
-            rgb.r = v;
-            rgb.g = p;
-            rgb.b = q;
-            break;
+    if (s == 0) {
+        rgb.r = v;
+        rgb.g = v;
+        rgb.b = v;
+        return rgb;
     }
 
+    uint8_t region    = h * 6 / 255;
+    uint8_t remainder = (h * 2 - region * 85) * 3;
+    uint8_t channel[4];
+
+    channel[0] = v;
+    channel[1] = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+    channel[2] = (v * (255 - s)) >> 8;
+    channel[3] = (v * (255 - ((s * remainder) >> 8))) >> 8;
+
+    // Pick the channels through a table rather than branching on the region
+    uint8_t order = hsv_regions[region];
+    rgb.r         = channel[order & 0x3];
+    rgb.g         = channel[(order >> 2) & 0x3];
+    rgb.b         = channel[order >> 4];
+
     return rgb;
 }
 
+rgb_t hsv_to_rgb_impl(hsv_t hsv, bool use_cie) {
+    return hsv_to_rgb_fixed(hsv.h, hsv.s, hsv_value(hsv.v, use_cie));
+}
+
 rgb_t hsv_to_rgb(hsv_t hsv) {
 #ifdef USE_CIE1931_CURVE
     return hsv_to_rgb_impl(hsv, true);
@@ -108,3 +84,9 @@ rgb_t hsv_to_rgb(hsv_t hsv) {
 rgb_t hsv_to_rgb_nocie(hsv_t hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
+
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb_fixed(hsv[i].h, hsv[i].s, hsv_value(hsv[i].v, true));
+    }
+}
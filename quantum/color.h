@@ -95,3 +95,6 @@ typedef hsv_t HSV;
 
 rgb_t hsv_to_rgb(hsv_t hsv);
 rgb_t hsv_to_rgb_nocie(hsv_t hsv);
+
+// Same result as hsv_to_rgb() for each of `count` colors
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint8_t count);
@@ -0,0 +1,28 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string.h>
+#include "matrix.h"
+
+/*
+Statically allocated debounce state, sized at compile time so that no debounce algorithm
+depends on a heap. Each half of a split keyboard only debounces its own rows, so the state
+covers ROWS_PER_HAND rows, the num_rows passed to debounce_init().
+*/
+
+#ifdef SPLIT_KEYBOARD
+#    define DEBOUNCE_STATE_ROWS ((MATRIX_ROWS) / 2)
+#else
+#    define DEBOUNCE_STATE_ROWS (MATRIX_ROWS)
+#endif
+
+// Declares one element of state per row
+#define DEBOUNCE_ROW_STATE(type, name) static type name[DEBOUNCE_STATE_ROWS]
+
+// Declares one element of state per key, row major
+#define DEBOUNCE_KEY_STATE(type, name) static type name[DEBOUNCE_STATE_ROWS * MATRIX_COLS]
+
+// Zeroes state declared with the macros above
+#define debounce_state_clear(name) memset(name, 0, sizeof(name))
@@ -0,0 +1,180 @@
+/*
+Copyright 2025 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Per-key eager algorithm, behaving exactly like sym_eager_pk.
+After pressing a key, it immediately changes state, and sets a counter.
+No further inputs are accepted until DEBOUNCE milliseconds have occurred.
+
+The counters are stored bit-sliced: plane n holds bit n of the counter of every key,
+with the same layout as the matrix. A whole row of counters is then decremented with
+a handful of word-wide operations instead of one loop iteration per key.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include "debounce_state.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+
+// Number of bit planes needed to hold DEBOUNCE
+#    if DEBOUNCE > 127
+#        define DEBOUNCE_PLANES 8
+#    elif DEBOUNCE > 63
+#        define DEBOUNCE_PLANES 7
+#    elif DEBOUNCE > 31
+#        define DEBOUNCE_PLANES 6
+#    elif DEBOUNCE > 15
+#        define DEBOUNCE_PLANES 5
+#    elif DEBOUNCE > 7
+#        define DEBOUNCE_PLANES 4
+#    elif DEBOUNCE > 3
+#        define DEBOUNCE_PLANES 3
+#    elif DEBOUNCE > 1
+#        define DEBOUNCE_PLANES 2
+#    else
+#        define DEBOUNCE_PLANES 1
+#    endif
+
+static matrix_row_t counter_planes[DEBOUNCE_PLANES][DEBOUNCE_STATE_ROWS];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         matrix_need_update;
+static bool         cooked_changed;
+
+static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// Keys with a running counter
+static inline matrix_row_t counters_active(uint8_t row) {
+    matrix_row_t active = 0;
+    for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+        active |= counter_planes[plane][row];
+    }
+    return active;
+}
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_state_clear(counter_planes);
+    counters_need_update = false;
+    matrix_need_update   = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters(num_rows, elapsed_time);
+        }
+    }
+
+    if (changed || matrix_need_update) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        transfer_matrix_values(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+// Subtract elapsed_time from every running counter, counters that would reach or pass zero expire.
+static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_need_update   = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t active = counters_active(row);
+        if (!active) {
+            continue;
+        }
+
+        // Ripple-borrow subtraction, one plane at a time for the whole row
+        matrix_row_t borrow    = 0;
+        matrix_row_t remaining = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            matrix_row_t a = counter_planes[plane][row];
+            matrix_row_t b = ((elapsed_time >> plane) & 1) ? ~(matrix_row_t)0 : 0;
+
+            // Keys without a running counter must stay at zero
+            counter_planes[plane][row] = (a ^ b ^ borrow) & active;
+            borrow                     = (~a & (b | borrow)) | (a & b & borrow);
+            remaining |= counter_planes[plane][row];
+        }
+        // elapsed_time may have bits above the planes, anything left of it is a borrow too
+        if (elapsed_time >> DEBOUNCE_PLANES) {
+            borrow = ~(matrix_row_t)0;
+        }
+
+        matrix_row_t expired = active & (borrow | ~remaining);
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            counter_planes[plane][row] &= ~expired;
+        }
+
+        if (expired) {
+            matrix_need_update = true;
+        }
+        if (active & ~expired) {
+            counters_need_update = true;
+        }
+    }
+}
+
+// upload from raw_matrix to final matrix;
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    matrix_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t flip = (raw[row] ^ cooked[row]) & ~counters_active(row);
+        if (!flip) {
+            continue;
+        }
+
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            if ((DEBOUNCE >> plane) & 1) {
+                counter_planes[plane][row] |= flip;
+            }
+        }
+        counters_need_update = true;
+        cooked[row] ^= flip;
+        cooked_changed = true;
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -32,6 +32,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "task_profiling.h"
+#include "task_deadline.h"
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -571,11 +576,52 @@ static inline void generate_tick_event(void) {
     static uint16_t last_tick = 0;
     const uint16_t  now       = timer_read();
     if (TIMER_DIFF_16(now, last_tick) != 0) {
-        action_exec(MAKE_TICK_EVENT);
+        // Ticks only drive pending tap-hold decisions and timeouts
+        if (action_tick_pending()) {
+            action_exec(MAKE_TICK_EVENT);
+        }
         last_tick = now;
     }
 }
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+// Time of the last key event from matrix_task(), events must not go back in time or the action code takes them for ones far in the future
+static uint16_t matrix_last_key_time = 0;
+
+/**
+ * @brief Replays the key events of the slave half with the time they happened
+ * there, before the matrix comparison would report them all at once.
+ *
+ * @return true Any key event was replayed
+ */
+static bool matrix_replay_split_events(matrix_row_t matrix_previous[]) {
+    const bool process_keypress = should_process_keypress();
+    bool       replayed         = false;
+
+    keyevent_t event;
+    while (split_matrix_event_dequeue(&event)) {
+        const matrix_row_t col_mask = (matrix_row_t)1 << event.key.col;
+        if (!!(matrix_previous[event.key.row] & col_mask) == event.pressed) {
+            // Already accounted for, by an earlier comparison of the whole matrix
+            continue;
+        }
+        matrix_previous[event.key.row] ^= col_mask;
+
+        if (TIMER_DIFF_16(event.time, matrix_last_key_time) > UINT16_MAX / 2) {
+            event.time = matrix_last_key_time;
+        }
+        matrix_last_key_time = event.time;
+
+        if (process_keypress) {
+            action_exec(event);
+        }
+        switch_events(event.key.row, event.key.col, event.pressed);
+        replayed = true;
+    }
+    return replayed;
+}
+#endif
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -592,6 +638,9 @@ static bool matrix_task(void) {
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
     matrix_scan();
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+    const bool replayed = matrix_replay_split_events(matrix_previous);
+#endif
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
         matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
@@ -602,7 +651,11 @@ static bool matrix_task(void) {
     // Short-circuit the complete matrix processing if it is not necessary
     if (!matrix_changed) {
         generate_tick_event();
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+        return replayed;
+#else
         return matrix_changed;
+#endif
     }
 
     if (debug_config.matrix) {
@@ -625,7 +678,13 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
+#ifdef LATENCY_TRACE_ENABLE
+                    keyevent_t event = MAKE_KEYEVENT(row, col, key_pressed);
+                    event.trace      = latency_trace_key_event(row, col);
+                    action_exec(event);
+#else
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+#endif
                 }
 
                 switch_events(row, col, key_pressed);
@@ -635,6 +694,9 @@ static bool matrix_task(void) {
         matrix_previous[row] = current_row;
     }
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+    matrix_last_key_time = timer_read();
+#endif
     return matrix_changed;
 }
 
@@ -673,7 +735,9 @@ void quantum_task(void) {
 #endif
 
 #ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
+    if (task_deadline_due(TASK_DEADLINE_KEY_OVERRIDE)) {
+        key_override_task();
+    }
 #endif
 
 #ifdef SEQUENCER_ENABLE
@@ -681,15 +745,21 @@ void quantum_task(void) {
 #endif
 
 #ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
+    if (task_deadline_due(TASK_DEADLINE_TAP_DANCE)) {
+        tap_dance_task();
+    }
 #endif
 
 #ifdef COMBO_ENABLE
-    combo_task();
+    if (task_deadline_due(TASK_DEADLINE_COMBO)) {
+        combo_task();
+    }
 #endif
 
 #ifdef LEADER_ENABLE
-    leader_task();
+    if (task_deadline_due(TASK_DEADLINE_LEADER)) {
+        leader_task();
+    }
 #endif
 
 #ifdef WPM_ENABLE
@@ -705,7 +775,9 @@ void quantum_task(void) {
 #endif
 
 #ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+    if (task_deadline_due(TASK_DEADLINE_CAPS_WORD)) {
+        caps_word_task();
+    }
 #endif
 
 #ifdef SECURE_ENABLE
@@ -713,39 +785,50 @@ void quantum_task(void) {
 #endif
 
 #ifdef LAYER_LOCK_ENABLE
-    layer_lock_task();
+    if (task_deadline_due(TASK_DEADLINE_LAYER_LOCK)) {
+        layer_lock_task();
+    }
 #endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
+    TASK_PROFILING_START();
+
     __attribute__((unused)) bool activity_has_occurred = false;
     if (matrix_task()) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
+    TASK_PROFILING_MARK(MATRIX);
 
     quantum_task();
+    TASK_PROFILING_MARK(QUANTUM);
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
+    TASK_PROFILING_MARK(SPLIT_WATCHDOG);
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
     rgblight_task();
+    TASK_PROFILING_MARK(RGBLIGHT);
 #endif
 
 #ifdef LED_MATRIX_ENABLE
     led_matrix_task();
+    TASK_PROFILING_MARK(LED_MATRIX);
 #endif
 #ifdef RGB_MATRIX_ENABLE
     rgb_matrix_task();
+    TASK_PROFILING_MARK(RGB_MATRIX);
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
     backlight_task();
 #    endif
+    TASK_PROFILING_MARK(BACKLIGHT);
 #endif
 
 #ifdef ENCODER_ENABLE
@@ -753,6 +836,7 @@ void keyboard_task(void) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
+    TASK_PROFILING_MARK(ENCODER);
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
@@ -760,6 +844,7 @@ void keyboard_task(void) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
+    TASK_PROFILING_MARK(POINTING_DEVICE);
 #endif
 
 #ifdef OLED_ENABLE
@@ -768,6 +853,7 @@ void keyboard_task(void) {
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
 #    endif
+    TASK_PROFILING_MARK(OLED);
 #endif
 
 #ifdef ST7565_ENABLE
@@ -776,40 +862,52 @@ void keyboard_task(void) {
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
 #    endif
+    TASK_PROFILING_MARK(ST7565);
 #endif
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
     mousekey_task();
+    TASK_PROFILING_MARK(MOUSEKEY);
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
     ps2_mouse_task();
+    TASK_PROFILING_MARK(PS2_MOUSE);
 #endif
 
 #ifdef MIDI_ENABLE
     midi_task();
+    TASK_PROFILING_MARK(MIDI);
 #endif
 
 #ifdef JOYSTICK_ENABLE
     joystick_task();
+    TASK_PROFILING_MARK(JOYSTICK);
 #endif
 
 #ifdef BATTERY_DRIVER
     battery_task();
+    TASK_PROFILING_MARK(BATTERY);
 #endif
 
 #ifdef BLUETOOTH_ENABLE
     bluetooth_task();
+    TASK_PROFILING_MARK(BLUETOOTH);
 #endif
 
 #ifdef HAPTIC_ENABLE
     haptic_task();
+    TASK_PROFILING_MARK(HAPTIC);
 #endif
 
     led_task();
+    TASK_PROFILING_MARK(LED);
 
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
+    TASK_PROFILING_MARK(OS_DETECTION);
 #endif
+
+    TASK_PROFILING_END();
 }
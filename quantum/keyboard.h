@@ -40,6 +40,9 @@ typedef struct {
     uint16_t        time;
     keyevent_type_t type;
     bool            pressed;
+#ifdef LATENCY_TRACE_ENABLE
+    uint32_t trace; // raw edge timestamp + 1, 0 if untraced
+#endif
 } keyevent_t;
 
 /* equivalent test of keypos_t */
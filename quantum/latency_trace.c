@@ -0,0 +1,170 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <inttypes.h>
+#include <string.h>
+#include "latency_trace.h"
+#include "basic_profiling.h"
+#include "debug.h"
+#include "print.h"
+
+static matrix_row_t edge_pending[MATRIX_ROWS];
+static uint32_t     edge_tag[MATRIX_ROWS][MATRIX_COLS];
+
+static latency_trace_entry_t entries[LATENCY_TRACE_BUFFER_SIZE];
+static uint8_t               entries_head;
+static uint8_t               entries_count;
+static uint32_t              entries_total;
+
+// The event currently being processed, and how deeply process_record() is nested
+static keyevent_t pending_event;
+static bool       pending;
+static uint8_t    depth;
+
+// Tags are stored off by one, so that 0 can mark untraced events
+static inline uint32_t trace_tag(void) {
+    return PROFILE_TIMESTAMP() + 1;
+}
+
+void latency_trace_matrix_scan(const matrix_row_t previous[], const matrix_row_t current[], const matrix_row_t debounced[], uint8_t row_offset, uint8_t rows) {
+    uint32_t tag = 0;
+    for (uint8_t row = 0; row < rows; row++) {
+        matrix_row_t changes = previous[row] ^ current[row];
+        if (!changes) {
+            continue;
+        }
+        if (!tag) {
+            tag = trace_tag();
+        }
+
+        // A bounce back to the debounced state cancels the edge, anything else starts one
+        matrix_row_t  differs = current[row] ^ debounced[row];
+        matrix_row_t *row_pending = &edge_pending[row_offset + row];
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_row_t col_mask = (matrix_row_t)1 << col;
+            if (!(changes & col_mask)) {
+                continue;
+            }
+            if (!(differs & col_mask)) {
+                *row_pending &= ~col_mask;
+            } else if (!(*row_pending & col_mask)) {
+                *row_pending |= col_mask;
+                edge_tag[row_offset + row][col] = tag;
+            }
+        }
+    }
+}
+
+uint32_t latency_trace_key_event(uint8_t row, uint8_t col) {
+    matrix_row_t col_mask = (matrix_row_t)1 << col;
+    if (edge_pending[row] & col_mask) {
+        edge_pending[row] &= ~col_mask;
+        return edge_tag[row][col];
+    }
+    // Custom matrices and the other half of split keyboards don't report raw edges
+    return trace_tag();
+}
+
+void latency_trace_begin(const keyevent_t *event) {
+    if (depth++ == 0 && event->trace) {
+        pending_event = *event;
+        pending       = true;
+    }
+}
+
+void latency_trace_end(void) {
+    if (depth && --depth == 0) {
+        pending = false;
+    }
+}
+
+void latency_trace_report_sent(void) {
+    if (!pending) {
+        return;
+    }
+    pending = false;
+
+    uint8_t                index = (entries_head + entries_count) % LATENCY_TRACE_BUFFER_SIZE;
+    latency_trace_entry_t *entry = &entries[index];
+    entry->key                   = pending_event.key;
+    entry->type                  = pending_event.type;
+    entry->pressed               = pending_event.pressed;
+    entry->latency_us            = PROFILE_ELAPSED_US(pending_event.trace - 1);
+
+    if (entries_count < LATENCY_TRACE_BUFFER_SIZE) {
+        entries_count++;
+    } else {
+        // Overwrite the oldest entry
+        entries_head = (entries_head + 1) % LATENCY_TRACE_BUFFER_SIZE;
+    }
+    entries_total++;
+
+    dprintf("latency: %u,%u %s %" PRIu32 " us\n", entry->key.row, entry->key.col, entry->pressed ? "down" : "up", entry->latency_us);
+}
+
+bool latency_trace_pop(latency_trace_entry_t *entry) {
+    if (!entries_count) {
+        return false;
+    }
+    *entry       = entries[entries_head];
+    entries_head = (entries_head + 1) % LATENCY_TRACE_BUFFER_SIZE;
+    entries_count--;
+    return true;
+}
+
+uint8_t latency_trace_count(void) {
+    return entries_count;
+}
+
+uint32_t latency_trace_total(void) {
+    return entries_total;
+}
+
+void latency_trace_clear(void) {
+    entries_head  = 0;
+    entries_count = 0;
+    entries_total = 0;
+}
+
+#define LATENCY_TRACE_ENTRY_SIZE 7
+
+void latency_trace_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, channel_id, trace_command_id, count, payload... ]
+    uint8_t *trace_command_id = &(data[2]);
+    uint8_t *count            = &(data[3]);
+    uint8_t *payload          = &(data[4]);
+
+    switch (*trace_command_id) {
+        case id_latency_trace_get_count:
+            *count     = entries_count;
+            payload[0] = entries_total >> 24;
+            payload[1] = entries_total >> 16;
+            payload[2] = entries_total >> 8;
+            payload[3] = entries_total & 0xFF;
+            break;
+        case id_latency_trace_read: {
+            // Each entry is [ row, col, pressed | type << 1, latency_us (big-endian u32) ]
+            uint8_t               max = (length - 4) / LATENCY_TRACE_ENTRY_SIZE;
+            latency_trace_entry_t entry;
+            *count = 0;
+            while (*count < max && latency_trace_pop(&entry)) {
+                uint8_t *out = &payload[*count * LATENCY_TRACE_ENTRY_SIZE];
+                out[0]       = entry.key.row;
+                out[1]       = entry.key.col;
+                out[2]       = entry.pressed | (entry.type << 1);
+                out[3]       = entry.latency_us >> 24;
+                out[4]       = entry.latency_us >> 16;
+                out[5]       = entry.latency_us >> 8;
+                out[6]       = entry.latency_us & 0xFF;
+                (*count)++;
+            }
+            break;
+        }
+        case id_latency_trace_clear:
+            latency_trace_clear();
+            break;
+        default:
+            *trace_command_id = id_latency_trace_unhandled;
+            break;
+    }
+}
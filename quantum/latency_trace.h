@@ -0,0 +1,73 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+#include "matrix.h"
+
+/*
+    End-to-end latency tracing from a raw matrix edge to the keyboard report.
+
+    The matrix scanner timestamps raw edges, the timestamp is carried along in
+    keyevent_t::trace through debounce, the tapping buffer and the combo buffer,
+    and the elapsed time is recorded once a keyboard report is sent while that
+    event is being processed.
+*/
+
+#ifndef LATENCY_TRACE_BUFFER_SIZE
+#    define LATENCY_TRACE_BUFFER_SIZE 32
+#endif
+
+typedef struct {
+    keypos_t        key;
+    keyevent_type_t type;
+    bool            pressed;
+    uint32_t        latency_us;
+} latency_trace_entry_t;
+
+enum latency_trace_command_id {
+    id_latency_trace_get_count = 0x01,
+    id_latency_trace_read      = 0x02,
+    id_latency_trace_clear     = 0x03,
+    id_latency_trace_unhandled = 0xFF,
+};
+
+/**
+ * \brief Timestamp raw edges of a freshly scanned matrix.
+ *
+ * \param previous The raw matrix of the previous scan.
+ * \param current The raw matrix that was just read.
+ * \param debounced The debounced matrix, before debounce() is applied to current.
+ * \param row_offset Row of the first entry, for the right half of split keyboards.
+ * \param rows Number of rows to check.
+ */
+void latency_trace_matrix_scan(const matrix_row_t previous[], const matrix_row_t current[], const matrix_row_t debounced[], uint8_t row_offset, uint8_t rows);
+
+/**
+ * \brief Returns the trace tag for a new key event, which is its raw edge timestamp if one was seen.
+ */
+uint32_t latency_trace_key_event(uint8_t row, uint8_t col);
+
+void latency_trace_begin(const keyevent_t *event);
+void latency_trace_end(void);
+
+/**
+ * \brief Called when a keyboard report is sent, records the latency of the event being processed.
+ */
+void latency_trace_report_sent(void);
+
+/**
+ * \brief Removes the oldest recorded entry.
+ *
+ * \return false if the buffer is empty.
+ */
+bool latency_trace_pop(latency_trace_entry_t *entry);
+
+uint8_t  latency_trace_count(void);
+uint32_t latency_trace_total(void);
+void     latency_trace_clear(void);
+
+void latency_trace_raw_hid_receive(uint8_t *data, uint8_t length);
@@ -0,0 +1,102 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "layer_cache.h"
+#include "action.h"
+#include "action_layer.h"
+
+#ifndef NO_ACTION_LAYER
+static uint8_t       layer_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t layer_cache_state = 0;
+static bool          layer_cache_valid = false;
+
+static inline layer_state_t effective_layer_state(void) {
+    return layer_state | default_layer_state;
+}
+
+static inline bool is_transparent(uint8_t layer, keypos_t key) {
+    return action_for_key(layer, key).code == ACTION_TRANSPARENT;
+}
+
+/** \brief Walk layers from the top
+ *
+ * Resolves the topmost non-transparent layer out of `layers`, falling back to
+ * `fallback` if all of them are transparent.
+ */
+static uint8_t resolve_layer(layer_state_t layers, keypos_t key, uint8_t fallback) {
+    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i)) {
+            if (!is_transparent(i, key)) {
+                return i;
+            }
+        }
+    }
+    return fallback;
+}
+
+static void layer_cache_rebuild(void) {
+    layer_state_t layers = effective_layer_state();
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t key          = {.row = row, .col = col};
+            layer_cache[row][col] = resolve_layer(layers, key, 0);
+        }
+    }
+    layer_cache_state = layers;
+    layer_cache_valid = true;
+}
+
+void layer_cache_update(void) {
+    if (!layer_cache_valid) {
+        // Nothing resolved yet, the first lookup will build the whole table
+        return;
+    }
+
+    layer_state_t layers = effective_layer_state();
+    if (layers == layer_cache_state) {
+        return;
+    }
+    layer_state_t added = layers & ~layer_cache_state;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t key     = {.row = row, .col = col};
+            uint8_t  current = layer_cache[row][col];
+
+            if (current != 0 && !(layers & ((layer_state_t)1 << current))) {
+                // Resolved layer went away, anything below it may now be exposed
+                layer_cache[row][col] = resolve_layer(layers, key, 0);
+            } else {
+                // Layers above the resolved one that were already active are transparent,
+                // so only the newly activated ones can take precedence
+                layer_state_t above = added & ~(layer_state_t)(((layer_state_t)2 << current) - 1);
+                if (above) {
+                    layer_cache[row][col] = resolve_layer(above, key, current);
+                }
+            }
+        }
+    }
+    layer_cache_state = layers;
+}
+
+void layer_cache_invalidate_key(keypos_t key) {
+    if (!layer_cache_valid || key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return;
+    }
+    layer_cache[key.row][key.col] = resolve_layer(layer_cache_state, key, 0);
+}
+
+void layer_cache_invalidate(void) {
+    layer_cache_valid = false;
+}
+
+uint8_t layer_cache_get_layer(keypos_t key) {
+    if (!layer_cache_valid) {
+        layer_cache_rebuild();
+    } else if (layer_cache_state != effective_layer_state()) {
+        // Layer state was written to directly, e.g. synced from the split master
+        layer_cache_update();
+    }
+    return layer_cache[key.row][key.col];
+}
+#endif
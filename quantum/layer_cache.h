@@ -0,0 +1,42 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "keyboard.h"
+
+/**
+ * @brief Get the topmost non-transparent layer for a matrix position
+ *
+ * Equivalent to walking the active layers from the top, but served from a per-key
+ * table of resolved layers. The table is brought up to date incrementally whenever
+ * the effective layer state differs from the one it was resolved against.
+ *
+ * @param key matrix position, must be within MATRIX_ROWS/MATRIX_COLS
+ * @return uint8_t resolved layer
+ */
+uint8_t layer_cache_get_layer(keypos_t key);
+
+/**
+ * @brief Re-resolve the cache against the current layer state
+ *
+ * Called when layer_state or default_layer_state change. Only the layers that were
+ * toggled since the last update are examined.
+ */
+void layer_cache_update(void);
+
+/**
+ * @brief Re-resolve a single matrix position
+ *
+ * Needs to be called whenever the keycode at a position changes on any layer,
+ * for example when writing to the dynamic keymap.
+ *
+ * @param key matrix position
+ */
+void layer_cache_invalidate_key(keypos_t key);
+
+/**
+ * @brief Discard the whole cache, it will be rebuilt on next use
+ */
+void layer_cache_invalidate(void);
@@ -14,6 +14,7 @@
 
 #include "layer_lock.h"
 #include "quantum_keycodes.h"
+#include "task_deadline.h"
 
 #ifndef NO_ACTION_LAYER
 // The current lock state. The kth bit is on if layer k is locked.
@@ -28,9 +29,17 @@ void layer_lock_timeout_task(void) {
         layer_lock_all_off();
         layer_lock_timer = timer_read32();
     }
+
+    if (locked_layers) {
+        uint32_t elapsed = timer_elapsed32(layer_lock_timer);
+        task_deadline_in(TASK_DEADLINE_LAYER_LOCK, elapsed > LAYER_LOCK_IDLE_TIMEOUT ? 0 : LAYER_LOCK_IDLE_TIMEOUT - elapsed + 1);
+    } else {
+        task_deadline_clear(TASK_DEADLINE_LAYER_LOCK);
+    }
 }
 void layer_lock_activity_trigger(void) {
     layer_lock_timer = timer_read32();
+    task_deadline_wake(TASK_DEADLINE_LAYER_LOCK);
 }
 #    else
 void layer_lock_timeout_task(void) {}
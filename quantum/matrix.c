@@ -22,6 +22,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "debounce.h"
 #include "atomic_util.h"
 
+#ifdef MATRIX_INTERRUPT_WAKEUP
+#    include "timer.h"
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -51,6 +58,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define MATRIX_INPUT_PRESSED_STATE 0
 #endif
 
+#ifdef MATRIX_INTERRUPT_WAKEUP
+#    if !defined(DIRECT_PINS) && !(defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS))
+#        error MATRIX_INTERRUPT_WAKEUP requires DIRECT_PINS or MATRIX_ROW_PINS/MATRIX_COL_PINS
+#    endif
+#    ifndef DEBOUNCE
+#        define DEBOUNCE 5
+#    endif
+#endif
+
 #ifdef DIRECT_PINS
 static SPLIT_MUTABLE pin_t direct_pins[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS;
 #elif (DIODE_DIRECTION == ROW2COL) || (DIODE_DIRECTION == COL2ROW)
@@ -270,6 +286,164 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_INTERRUPT_WAKEUP
+/* While no key is held, every output line is selected at once so that any key press pulls
+ * one of the inputs to its pressed state. Scanning is then skipped until an input changes,
+ * either signalled through a pin change interrupt or, on platforms without
+ * gpio_enable_pin_interrupt() and when inputs share an interrupt line, detected by a single
+ * read of the inputs. */
+static bool               matrix_idle                      = false;
+static bool               matrix_idle_interrupts           = false;
+static volatile bool      matrix_wakeup                    = false;
+static uint16_t           matrix_last_event                = 0;
+static const matrix_row_t matrix_idle_empty[ROWS_PER_HAND] = {0};
+
+#    ifdef gpio_enable_pin_interrupt
+static void matrix_wakeup_callback(void *arg) {
+    (void)arg;
+    matrix_wakeup = true;
+}
+#    endif
+
+#    ifdef DIRECT_PINS
+#        define MATRIX_IDLE_INPUTS (ROWS_PER_HAND * MATRIX_COLS)
+#        define matrix_idle_input_pin(index) (direct_pins[(index) / MATRIX_COLS][(index) % MATRIX_COLS])
+#    elif (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_IDLE_INPUTS MATRIX_COLS
+#        define matrix_idle_input_pin(index) (col_pins[index])
+#    elif (DIODE_DIRECTION == ROW2COL)
+#        define MATRIX_IDLE_INPUTS ROWS_PER_HAND
+#        define matrix_idle_input_pin(index) (row_pins[index])
+#    endif
+
+static void matrix_idle_init(void) {
+#    ifdef gpio_enable_pin_interrupt
+    matrix_idle_interrupts = true;
+#        ifdef gpio_pin_interrupt_line
+    // Only one pin per interrupt line can be armed at a time, so a shared line could miss a key press
+    for (uint16_t x = 0; x < MATRIX_IDLE_INPUTS; x++) {
+        pin_t pin = matrix_idle_input_pin(x);
+        if (pin == NO_PIN) {
+            continue;
+        }
+        for (uint16_t y = x + 1; y < MATRIX_IDLE_INPUTS; y++) {
+            pin_t other = matrix_idle_input_pin(y);
+            if (other != NO_PIN && gpio_pin_interrupt_line(pin) == gpio_pin_interrupt_line(other)) {
+                matrix_idle_interrupts = false;
+                return;
+            }
+        }
+    }
+#        endif
+#    endif
+}
+
+static void matrix_idle_select_all(void) {
+#    if defined(DIRECT_PINS)
+    // inputs are tied to ground directly, nothing to select
+#    elif (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        select_row(x);
+    }
+    matrix_output_select_delay();
+#    elif (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        select_col(x);
+    }
+    matrix_output_select_delay();
+#    endif
+}
+
+static void matrix_idle_unselect_all(void) {
+#    if defined(DIRECT_PINS)
+    // inputs are tied to ground directly, nothing to unselect
+#    elif (DIODE_DIRECTION == COL2ROW)
+    unselect_rows();
+    matrix_output_unselect_delay(0, true);
+#    elif (DIODE_DIRECTION == ROW2COL)
+    unselect_cols();
+    matrix_output_unselect_delay(0, true);
+#    endif
+}
+
+static bool matrix_idle_any_pressed(void) {
+    for (uint16_t x = 0; x < MATRIX_IDLE_INPUTS; x++) {
+        if (readMatrixPin(matrix_idle_input_pin(x)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void matrix_idle_enter(void) {
+    matrix_idle_select_all();
+#    ifdef gpio_enable_pin_interrupt
+    matrix_wakeup = false;
+    for (uint16_t x = 0; matrix_idle_interrupts && x < MATRIX_IDLE_INPUTS; x++) {
+        pin_t pin = matrix_idle_input_pin(x);
+        if (pin != NO_PIN) {
+            gpio_enable_pin_interrupt(pin, matrix_wakeup_callback);
+        }
+    }
+#    endif
+    matrix_idle = true;
+
+    // A key may have gone down after the last full scan but before the interrupts were armed
+    if (matrix_idle_any_pressed()) {
+        matrix_wakeup = true;
+    }
+}
+
+static void matrix_idle_exit(void) {
+#    ifdef gpio_enable_pin_interrupt
+    for (uint16_t x = 0; matrix_idle_interrupts && x < MATRIX_IDLE_INPUTS; x++) {
+        pin_t pin = matrix_idle_input_pin(x);
+        if (pin != NO_PIN) {
+            gpio_disable_pin_interrupt(pin);
+        }
+    }
+#    endif
+    matrix_idle_unselect_all();
+    matrix_idle   = false;
+    matrix_wakeup = false;
+}
+
+/** \brief Check whether the full scan can be skipped
+ *
+ * Leaves idle mode as soon as any input reports a change.
+ */
+static bool matrix_idle_task(void) {
+    if (!matrix_idle) {
+        return false;
+    }
+    if (!matrix_wakeup && (matrix_idle_interrupts || !matrix_idle_any_pressed())) {
+        return true;
+    }
+    matrix_idle_exit();
+    return false;
+}
+
+/** \brief Enter idle mode once all keys are released and debounce has settled
+ */
+static void matrix_idle_update(matrix_row_t debounced[], bool raw_changed) {
+    if (raw_changed) {
+        matrix_last_event = timer_read();
+        return;
+    }
+    if (timer_elapsed(matrix_last_event) <= DEBOUNCE) {
+        return;
+    }
+    if (memcmp(raw_matrix, matrix_idle_empty, sizeof(matrix_idle_empty)) != 0 || memcmp(debounced, matrix_idle_empty, sizeof(matrix_idle_empty)) != 0) {
+        return;
+    }
+    matrix_idle_enter();
+}
+
+bool matrix_is_idle(void) {
+    return matrix_idle;
+}
+#endif
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -309,6 +483,12 @@ void matrix_init(void) {
 
     debounce_init(ROWS_PER_HAND);
 
+#ifdef MATRIX_INTERRUPT_WAKEUP
+    matrix_idle_init();
+    matrix_idle       = false;
+    matrix_last_event = timer_read();
+#endif
+
     matrix_init_kb();
 }
 
@@ -320,30 +500,58 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
-uint8_t matrix_scan(void) {
-    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
-
+static void matrix_read(matrix_row_t current_matrix[]) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
-        matrix_read_cols_on_row(curr_matrix, current_row);
+        matrix_read_cols_on_row(current_matrix, current_row);
     }
 #elif (DIODE_DIRECTION == ROW2COL)
     // Set col, read rows
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
-        matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
+        matrix_read_rows_on_col(current_matrix, current_col, row_shifter);
+    }
+#endif
+}
+
+uint8_t matrix_scan(void) {
+    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
+
+#ifdef MATRIX_INTERRUPT_WAKEUP
+    // Idle mode is only entered with an empty raw matrix, so curr_matrix is already up to date
+    if (!matrix_idle_task()) {
+        matrix_read(curr_matrix);
     }
+#else
+    matrix_read(curr_matrix);
 #endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
+#ifdef LATENCY_TRACE_ENABLE
+#    ifdef SPLIT_KEYBOARD
+    if (changed) latency_trace_matrix_scan(raw_matrix, curr_matrix, matrix + thisHand, thisHand, ROWS_PER_HAND);
+#    else
+    if (changed) latency_trace_matrix_scan(raw_matrix, curr_matrix, matrix, 0, ROWS_PER_HAND);
+#    endif
+#endif
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
+#ifdef MATRIX_INTERRUPT_WAKEUP
+    bool raw_changed = changed;
+#endif
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
+#endif
+#ifdef MATRIX_INTERRUPT_WAKEUP
+#    ifdef SPLIT_KEYBOARD
+    if (!matrix_idle) matrix_idle_update(matrix + thisHand, raw_changed);
+#    else
+    if (!matrix_idle) matrix_idle_update(matrix, raw_changed);
+#    endif
 #endif
     return (uint8_t)changed;
 }
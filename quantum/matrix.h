@@ -53,6 +53,10 @@ void matrix_init(void);
 uint8_t matrix_scan(void);
 /* whether matrix scanning operations should be executed */
 bool matrix_can_read(void);
+#ifdef MATRIX_INTERRUPT_WAKEUP
+/* whether scanning is suspended until a key press wakes the matrix up */
+bool matrix_is_idle(void);
+#endif
 /* whether a switch is on */
 bool matrix_is_on(uint8_t row, uint8_t col);
 /* matrix state on row */
@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -26,6 +27,8 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "debug.h"
+#include "task_deadline.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -102,6 +105,29 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_INDEX_SIZE
+/* Every (keycode, combo) pair as keycode << 16 | combo_index, sorted, so a key event
+ * only visits the combos containing its keycode. */
+static uint32_t combo_index[COMBO_INDEX_SIZE];
+static uint16_t combo_index_length   = 0;
+static bool     combo_index_valid    = false;
+static bool     combo_index_overflow = false;
+
+/* Combos that may have a non-zero state, which clear_combos() has to reset. */
+static uint8_t  combo_touched[(COMBO_INDEX_SIZE + 7) / 8];
+static uint16_t combo_touched_count = 0;
+
+#    define COMBO_INDEX_KEYCODE(i) ((uint16_t)(combo_index[i] >> 16))
+#    define COMBO_INDEX_COMBO(i) ((uint16_t)(combo_index[i] & 0xFFFF))
+
+static inline void touch_combo(uint16_t idx) {
+    if (!(combo_touched[idx / 8] & (1 << (idx % 8)))) {
+        combo_touched[idx / 8] |= 1 << (idx % 8);
+        combo_touched_count++;
+    }
+}
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -199,9 +225,103 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
     return COMBO_TERM;
 }
 
+#ifdef COMBO_INDEX_SIZE
+static void combo_index_build(void) {
+    uint16_t count = combo_count();
+
+    combo_index_length   = 0;
+    combo_index_overflow = count > COMBO_INDEX_SIZE;
+    for (uint16_t idx = 0; idx < count && !combo_index_overflow; idx++) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; i++) {
+            if (combo_index_length == COMBO_INDEX_SIZE) {
+                combo_index_overflow = true;
+                break;
+            }
+            combo_index[combo_index_length++] = ((uint32_t)key << 16) | idx;
+        }
+    }
+
+    if (combo_index_overflow) {
+        dprintln("combo: COMBO_INDEX_SIZE too small, falling back to a linear scan");
+        combo_index_length = 0;
+    }
+
+    // Shell sort, this only runs once so small code beats speed
+    for (uint16_t gap = combo_index_length / 2; gap > 0; gap /= 2) {
+        for (uint16_t i = gap; i < combo_index_length; i++) {
+            uint32_t entry = combo_index[i];
+            uint16_t j     = i;
+            for (; j >= gap && combo_index[j - gap] > entry; j -= gap) {
+                combo_index[j] = combo_index[j - gap];
+            }
+            combo_index[j] = entry;
+        }
+    }
+
+    // A keycode listed twice in a combo must only visit it once
+    uint16_t unique = 0;
+    for (uint16_t i = 0; i < combo_index_length; i++) {
+        if (unique == 0 || combo_index[unique - 1] != combo_index[i]) {
+            combo_index[unique++] = combo_index[i];
+        }
+    }
+    combo_index_length = unique;
+
+    // The states of existing combos are unknown, let the next clear_combos() walk all of them
+    memset(combo_touched, 0, sizeof(combo_touched));
+    combo_touched_count = 0;
+    for (uint16_t idx = 0; idx < count && !combo_index_overflow; idx++) {
+        touch_combo(idx);
+    }
+    combo_index_valid = true;
+}
+
+static uint16_t combo_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_index_length;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (COMBO_INDEX_KEYCODE(mid) < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void combo_index_invalidate(void) {
+    combo_index_valid = false;
+}
+#endif
+
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_INDEX_SIZE
+    if (combo_index_valid && !combo_index_overflow) {
+        uint16_t count = combo_count();
+        for (uint16_t byte = 0; combo_touched_count && byte < (count + 7) / 8; byte++) {
+            if (!combo_touched[byte]) {
+                continue;
+            }
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                index = byte * 8 + bit;
+                if (index >= count || !(combo_touched[byte] & (1 << bit))) {
+                    continue;
+                }
+                combo_t *combo = combo_get(index);
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                    combo_touched[byte] &= ~(1 << bit);
+                    combo_touched_count--;
+                }
+            }
+        }
+        return;
+    }
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -581,10 +701,24 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX_SIZE
+    if (!combo_index_valid) {
+        combo_index_build();
+    }
+    if (!combo_index_overflow) {
+        for (uint16_t i = combo_index_find(keycode); i < combo_index_length && COMBO_INDEX_KEYCODE(i) == keycode; i++) {
+            uint16_t idx = COMBO_INDEX_COMBO(i);
+            touch_combo(idx);
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -629,6 +763,7 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
 
 void combo_task(void) {
     if (!b_combo_enable) {
+        task_deadline_clear(TASK_DEADLINE_COMBO);
         return;
     }
 
@@ -644,7 +779,14 @@ void combo_task(void) {
             clear_combos();
         }
     }
+
+    if (timer) {
+        uint16_t elapsed = timer_elapsed(timer);
+        task_deadline_in(TASK_DEADLINE_COMBO, elapsed > longest_term ? 0 : longest_term - elapsed + 1);
+        return;
+    }
 #endif
+    task_deadline_clear(TASK_DEADLINE_COMBO);
 }
 
 void combo_enable(void) {
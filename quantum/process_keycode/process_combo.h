@@ -77,6 +77,13 @@ bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
+#ifdef COMBO_INDEX_SIZE
+/**
+ * \brief Rebuild the keycode index on the next key event, after combos have been changed at runtime.
+ */
+void combo_index_invalidate(void);
+#endif
+
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
@@ -24,6 +24,7 @@
 #include "quantum.h"
 #include "quantum_keycodes.h"
 #include "keymap_introspection.h"
+#include "task_deadline.h"
 
 #ifndef KEY_OVERRIDE_REPEAT_DELAY
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
@@ -393,15 +394,20 @@ static bool try_activating_override(const uint16_t keycode, const uint8_t layer,
 
 void key_override_task(void) {
     if (deferred_register == 0) {
+        task_deadline_clear(TASK_DEADLINE_KEY_OVERRIDE);
         return;
     }
 
-    if (timer_elapsed32(defer_reference_time) >= defer_delay) {
+    uint32_t elapsed = timer_elapsed32(defer_reference_time);
+    if (elapsed >= defer_delay) {
         key_override_printf("Registering deferred key\n");
         register_code16(deferred_register);
         deferred_register    = 0;
         defer_reference_time = 0;
         defer_delay          = 0;
+        task_deadline_clear(TASK_DEADLINE_KEY_OVERRIDE);
+    } else {
+        task_deadline_in(TASK_DEADLINE_KEY_OVERRIDE, defer_delay - elapsed);
     }
 }
 
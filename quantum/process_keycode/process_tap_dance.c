@@ -22,6 +22,7 @@
 #include "timer.h"
 #include "wait.h"
 #include "keymap_introspection.h"
+#include "task_deadline.h"
 
 static uint16_t active_td;
 static uint16_t last_tap_time;
@@ -186,12 +187,23 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 void tap_dance_task(void) {
     tap_dance_action_t *action;
 
-    if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
+    if (!active_td) {
+        task_deadline_clear(TASK_DEADLINE_TAP_DANCE);
+        return;
+    }
+
+    uint16_t term    = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+    uint16_t elapsed = timer_elapsed(last_tap_time);
+    if (elapsed <= term) {
+        task_deadline_in(TASK_DEADLINE_TAP_DANCE, term - elapsed + 1);
+        return;
+    }
 
     action = tap_dance_get(QK_TAP_DANCE_GET_INDEX(active_td));
     if (!action->state.interrupted) {
         process_tap_dance_action_on_dance_finished(action);
     }
+    task_deadline_clear(TASK_DEADLINE_TAP_DANCE);
 }
 
 void reset_tap_dance(tap_dance_state_t *state) {
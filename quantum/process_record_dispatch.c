@@ -0,0 +1,19 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "process_record_dispatch.h"
+#include "progmem.h"
+
+bool process_record_dispatch(const process_record_route_t *routes, uint8_t count, uint16_t keycode, keyrecord_t *record) {
+    for (uint8_t i = 0; i < count; i++) {
+        const process_record_route_t *route = &routes[i];
+        if (keycode < pgm_read_word(&route->first) || keycode > pgm_read_word(&route->last)) {
+            continue;
+        }
+        process_record_handler_t handler = (process_record_handler_t)pgm_read_ptr(&route->handler);
+        if (!handler(keycode, record)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action.h"
+
+typedef bool (*process_record_handler_t)(uint16_t keycode, keyrecord_t *record);
+
+/**
+ * @brief A process_record handler and the keycodes it acts upon
+ *
+ * The handler is only called for keycodes within `first` and `last`, inclusive. Handlers
+ * that have to see every key, for example to record it or to cancel their own state,
+ * observe the whole keycode space instead.
+ */
+typedef struct {
+    process_record_handler_t handler;
+    uint16_t                 first;
+    uint16_t                 last;
+} process_record_route_t;
+
+#define PROCESS_RECORD_OBSERVE_ALL(handler) \
+    { handler, 0x0000, 0xFFFF }
+#define PROCESS_RECORD_RANGE(handler, first, last) \
+    { handler, first, last }
+
+/**
+ * @brief Run the handlers routed to `keycode`, in table order
+ *
+ * Stops at the first handler returning false. The table is expected to live in PROGMEM.
+ *
+ * @return false if a handler consumed the record, true otherwise
+ */
+bool process_record_dispatch(const process_record_route_t *routes, uint8_t count, uint16_t keycode, keyrecord_t *record);
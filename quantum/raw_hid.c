@@ -4,6 +4,19 @@
 #include "raw_hid.h"
 #include "host.h"
 
+#ifdef TASK_PROFILING_ENABLE
+#    include "task_profiling.h"
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+#if defined(RGB_MATRIX_ENABLE) && defined(ENABLE_RGB_MATRIX_DIRECT)
+#    include "rgb_matrix_direct.h"
+#endif
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_COMMON_TRANSACTIONS) && defined(SPLIT_TRANSACTION_STATS_ENABLE)
+#    include "transactions.h"
+#endif
+
 void raw_hid_send(uint8_t *data, uint8_t length) {
     host_raw_hid_send(data, length);
 }
@@ -13,3 +26,41 @@ __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // and implement this function there. Leave this as weak linkage
     // so users can opt to not handle data coming in.
 }
+
+bool raw_hid_receive_quantum(uint8_t *data, uint8_t length) {
+    // data = [ command_id, channel_id, ... ]
+    if (length < 2 || data[0] != RAW_HID_QUANTUM_COMMAND_ID) {
+        return false;
+    }
+
+    switch (data[1]) {
+#ifdef TASK_PROFILING_ENABLE
+        case id_task_profiling_channel:
+            task_profiling_raw_hid_receive(data, length);
+            break;
+#endif // TASK_PROFILING_ENABLE
+#ifdef LATENCY_TRACE_ENABLE
+        case id_latency_trace_channel:
+            latency_trace_raw_hid_receive(data, length);
+            break;
+#endif // LATENCY_TRACE_ENABLE
+#if defined(RGB_MATRIX_ENABLE) && defined(ENABLE_RGB_MATRIX_DIRECT)
+        case id_rgb_matrix_direct_channel:
+            // Frame reports are only answered when asked, so the host can stream without waiting
+            if (!rgb_matrix_direct_raw_hid_receive(data, length)) {
+                return true;
+            }
+            break;
+#endif // ENABLE_RGB_MATRIX_DIRECT
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_COMMON_TRANSACTIONS) && defined(SPLIT_TRANSACTION_STATS_ENABLE)
+        case id_split_transaction_stats_channel:
+            transactions_stats_raw_hid_receive(data, length);
+            break;
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+        default:
+            return false;
+    }
+
+    raw_hid_send(data, length);
+    return true;
+}
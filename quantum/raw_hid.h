@@ -4,6 +4,11 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#ifndef RAW_HID_QUANTUM_COMMAND_ID
+#    define RAW_HID_QUANTUM_COMMAND_ID 0xFD
+#endif
 
 /**
  * \file
@@ -28,4 +33,25 @@ void raw_hid_receive(uint8_t *data, uint8_t length);
  */
 void raw_hid_send(uint8_t *data, uint8_t length);
 
+/**
+ * \brief Channels of the built-in command handler.
+ *
+ * Reports starting with RAW_HID_QUANTUM_COMMAND_ID are routed on their second byte.
+ */
+enum raw_hid_quantum_channel_id {
+    id_task_profiling_channel          = 0x01,
+    id_latency_trace_channel           = 0x02,
+    id_rgb_matrix_direct_channel       = 0x03,
+    id_split_transaction_stats_channel = 0x04,
+};
+
+/**
+ * \brief Handle reports addressed to built-in features, before raw_hid_receive() sees them.
+ *
+ * \param data A pointer to the received data, the reply is written back in place.
+ * \param length The length of the buffer.
+ * \return true if the report was handled and a reply has been sent.
+ */
+bool raw_hid_receive_quantum(uint8_t *data, uint8_t length);
+
 /** \} */
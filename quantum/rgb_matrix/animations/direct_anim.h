@@ -0,0 +1,17 @@
+#ifdef ENABLE_RGB_MATRIX_DIRECT
+RGB_MATRIX_EFFECT(DIRECT)
+#    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+
+// Colors are written by the host as reports arrive, see rgb_matrix_direct.c.
+// Rendering and flushing are held back while a frame is partway through, so a flush never shows half of one.
+bool DIRECT(effect_params_t* params) {
+    bool receiving = rgb_matrix_direct_receiving();
+    // Start from black, unless the host has already begun drawing
+    if (params->init && params->iter == 0 && !receiving) {
+        rgb_matrix_set_color_all(RGB_OFF);
+    }
+    return receiving;
+}
+
+#    endif // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#endif     // ENABLE_RGB_MATRIX_DIRECT
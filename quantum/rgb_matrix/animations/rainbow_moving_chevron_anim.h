@@ -3,7 +3,7 @@ RGB_MATRIX_EFFECT(RAINBOW_MOVING_CHEVRON)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 static hsv_t RAINBOW_MOVING_CHEVRON_math(hsv_t hsv, uint8_t i, uint8_t time) {
-    hsv.h += abs8(g_led_config.point[i].y - k_rgb_matrix_center.y) + (g_led_config.point[i].x - time);
+    hsv.h += abs8(rgb_matrix_led_dy(i)) + (g_led_config.point[i].x - time);
     return hsv;
 }
 
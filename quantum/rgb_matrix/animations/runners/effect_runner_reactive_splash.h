@@ -3,27 +3,70 @@
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 
 typedef hsv_t (*reactive_splash_f)(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+// Range of distances from a hit that effect_func can still light at tick, false once it lights nothing
+typedef bool (*reactive_splash_reach_f)(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+typedef struct {
+    uint8_t  x;
+    uint8_t  y;
+    uint16_t tick;
+    uint8_t  min_dist;
+    uint8_t  max_dist;
+} reactive_splash_hit_t;
+
+bool effect_runner_reactive_splash_culled(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    // Work out once per run where each hit can still reach, dropping those that reach nowhere
+    reactive_splash_hit_t hits[LED_HITS_TO_REMEMBER];
+    uint8_t               count = 0;
+    for (uint8_t j = start; j < g_last_hit_tracker.count; j++) {
+        reactive_splash_hit_t* hit = &hits[count];
+        hit->x                     = g_last_hit_tracker.x[j];
+        hit->y                     = g_last_hit_tracker.y[j];
+        hit->tick                  = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        hit->min_dist              = 0;
+        hit->max_dist              = UINT8_MAX;
+        if (!reach_func || reach_func(hit->tick, &hit->min_dist, &hit->max_dist)) {
+            count++;
+        }
+    }
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         hsv_t hsv = rgb_matrix_config.hsv;
         hsv.v     = 0;
-        for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+        for (uint8_t j = 0; j < count; j++) {
+            const reactive_splash_hit_t* hit = &hits[j];
+
+            // Bounding box of the ring first, so most far away hits cost no square root
+            int16_t dx = g_led_config.point[i].x - hit->x;
+            if (dx > hit->max_dist || dx < -hit->max_dist) continue;
+            int16_t dy = g_led_config.point[i].y - hit->y;
+            if (dy > hit->max_dist || dy < -hit->max_dist) continue;
+
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            if (dist < hit->min_dist || dist > hit->max_dist) continue;
+
+            hsv = effect_func(hsv, dx, dy, dist, hit->tick);
         }
-        hsv.v     = scale8(hsv.v, rgb_matrix_config.hsv.v);
-        rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        rgb_matrix_render_hsv(i, hsv);
     }
+    rgb_matrix_render_hsv_flush();
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+// Reach of effects that fade out with tick - dist, a ring 255 wide expanding from the hit
+bool reactive_splash_ring_reach(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist) {
+    if (tick > 254 + UINT8_MAX) return false;
+    *min_dist = tick > 254 ? tick - 254 : 0;
+    *max_dist = tick > UINT8_MAX ? UINT8_MAX : tick;
+    return true;
+}
+
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_culled(start, params, effect_func, NULL);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -27,3 +27,8 @@
     defined(ENABLE_RGB_MATRIX_SOLID_MULTISPLASH)
 #    define RGB_MATRIX_KEYPRESSES
 #endif
+
+// direct
+#if defined(ENABLE_RGB_MATRIX_DIRECT) && !defined(RAW_ENABLE)
+#    error "ENABLE_RGB_MATRIX_DIRECT requires RAW_ENABLE = yes"
+#endif
@@ -22,6 +22,13 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#include "wait.h"
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+#    include "basic_profiling.h"
+#endif
+#ifdef ENABLE_RGB_MATRIX_DIRECT
+#    include "rgb_matrix_direct.h"
+#endif
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -38,6 +45,73 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// LED position relative to the center, read from the geometry cache when enabled
+static inline int16_t rgb_matrix_led_dx(uint8_t i) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    return g_led_geometry[i].dx;
+#else
+    return g_led_config.point[i].x - k_rgb_matrix_center.x;
+#endif
+}
+
+static inline int16_t rgb_matrix_led_dy(uint8_t i) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    return g_led_geometry[i].dy;
+#else
+    return g_led_config.point[i].y - k_rgb_matrix_center.y;
+#endif
+}
+
+static inline uint8_t rgb_matrix_led_dist(uint8_t i) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    return g_led_geometry[i].dist;
+#else
+    int16_t dx = rgb_matrix_led_dx(i);
+    int16_t dy = rgb_matrix_led_dy(i);
+    return sqrt16(dx * dx + dy * dy);
+#endif
+}
+
+static inline uint8_t rgb_matrix_led_angle(uint8_t i) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    return g_led_geometry[i].angle;
+#else
+    return atan2_8(rgb_matrix_led_dy(i), rgb_matrix_led_dx(i));
+#endif
+}
+
+#ifdef RGB_MATRIX_HSV_BATCH
+// Runner output waiting for a bulk HSV to RGB conversion, bypasses rgb_matrix_hsv_to_rgb()
+static uint8_t rgb_hsv_batch_led[RGB_MATRIX_HSV_BATCH];
+static hsv_t   rgb_hsv_batch[RGB_MATRIX_HSV_BATCH];
+static uint8_t rgb_hsv_batch_count = 0;
+
+static void rgb_matrix_render_hsv_flush(void) {
+    rgb_t rgb[RGB_MATRIX_HSV_BATCH];
+
+    hsv_to_rgb_batch(rgb_hsv_batch, rgb, rgb_hsv_batch_count);
+    for (uint8_t i = 0; i < rgb_hsv_batch_count; i++) {
+        rgb_matrix_set_color(rgb_hsv_batch_led[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    rgb_hsv_batch_count = 0;
+}
+
+static inline void rgb_matrix_render_hsv(uint8_t i, hsv_t hsv) {
+    rgb_hsv_batch_led[rgb_hsv_batch_count] = i;
+    rgb_hsv_batch[rgb_hsv_batch_count]     = hsv;
+    if (++rgb_hsv_batch_count == RGB_MATRIX_HSV_BATCH) {
+        rgb_matrix_render_hsv_flush();
+    }
+}
+#else
+static inline void rgb_matrix_render_hsv(uint8_t i, hsv_t hsv) {
+    rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
+    rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+}
+
+static inline void rgb_matrix_render_hsv_flush(void) {}
+#endif // RGB_MATRIX_HSV_BATCH
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -71,6 +145,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_GEOMETRY_CACHE
 
 // internals
 static bool            suspend_state     = false;
@@ -83,8 +160,20 @@ static rgb_task_states rgb_task_state    = SYNCING;
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 static last_hit_t last_hit_buffer;
+// Scaled tick after which no core effect shows a hit anymore, the end of reactive_splash_ring_reach()
+#    define RGB_MATRIX_HIT_EXPIRED_TICK (254 + UINT8_MAX)
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+// adaptive rendering
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+static struct rgb_matrix_limits_t rgb_render_limits;
+static uint16_t                   rgb_render_led_cost    = 0; // in 1/16 microseconds per LED, 0 until measured
+static uint8_t                    rgb_render_cost_effect = UINT8_MAX;
+static uint32_t                   rgb_fps_timer          = 0;
+static uint16_t                   rgb_fps_frames         = 0;
+static uint16_t                   rgb_fps                = 0;
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
 // split rgb matrix
 #if defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
@@ -167,6 +256,88 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+// Hits are kept oldest first, drops the oldest `count` of them
+static void rgb_matrix_drop_hits(uint8_t count) {
+    uint8_t keep = last_hit_buffer.count - count;
+    memmove(&last_hit_buffer.x[0], &last_hit_buffer.x[count], keep);
+    memmove(&last_hit_buffer.y[0], &last_hit_buffer.y[count], keep);
+    memmove(&last_hit_buffer.tick[0], &last_hit_buffer.tick[count], keep * 2); // 16 bit
+    memmove(&last_hit_buffer.index[0], &last_hit_buffer.index[count], keep);
+    last_hit_buffer.count = keep;
+}
+
+// Appends a hit, dropping the oldest one when the buffer is full
+static void rgb_matrix_add_hit(uint8_t led, uint16_t tick) {
+    if (last_hit_buffer.count == LED_HITS_TO_REMEMBER) {
+        rgb_matrix_drop_hits(1);
+    }
+    uint8_t index                = last_hit_buffer.count;
+    last_hit_buffer.x[index]     = g_led_config.point[led].x;
+    last_hit_buffer.y[index]     = g_led_config.point[led].y;
+    last_hit_buffer.index[index] = led;
+    last_hit_buffer.tick[index]  = tick;
+    last_hit_buffer.count++;
+}
+
+#    ifdef RGB_MATRIX_SPLIT
+// Hits the slave has not acknowledged yet, as LED and sync timer at the time of the hit, numbered from split_hit_first
+static uint8_t  split_hit_led[LED_HITS_TO_REMEMBER];
+static uint16_t split_hit_time[LED_HITS_TO_REMEMBER];
+static uint8_t  split_hit_count = 0;
+static uint8_t  split_hit_first = 0;
+
+static void rgb_matrix_split_drop_hits(uint8_t count) {
+    uint8_t keep = split_hit_count - count;
+    memmove(&split_hit_led[0], &split_hit_led[count], keep);
+    memmove(&split_hit_time[0], &split_hit_time[count], keep * 2); // 16 bit
+    split_hit_count = keep;
+    split_hit_first += count;
+}
+
+static void rgb_matrix_split_queue_hit(uint8_t led) {
+    // The slave would only keep the newest hits anyway
+    if (split_hit_count == LED_HITS_TO_REMEMBER) {
+        rgb_matrix_split_drop_hits(1);
+    }
+    split_hit_led[split_hit_count]  = led;
+    split_hit_time[split_hit_count] = sync_timer_read();
+    split_hit_count++;
+}
+
+uint8_t rgb_matrix_split_get_hits(rgb_matrix_split_hit_t hits[LED_HITS_TO_REMEMBER], uint8_t *first) {
+    uint16_t now = sync_timer_read();
+    for (uint8_t i = 0; i < split_hit_count; i++) {
+        uint16_t age = TIMER_DIFF_16(now, split_hit_time[i]);
+        hits[i].led  = split_hit_led[i];
+        hits[i].tick = age < UINT8_MAX ? age : UINT8_MAX;
+    }
+    *first = split_hit_first;
+    return split_hit_count;
+}
+
+void rgb_matrix_split_hits_acked(uint8_t next) {
+    // Anything else is an acknowledgement from before hits were dropped here or the slave restarted
+    uint8_t acked = next - split_hit_first;
+    if (acked <= split_hit_count) {
+        rgb_matrix_split_drop_hits(acked);
+    }
+}
+
+void rgb_matrix_split_add_hits(const rgb_matrix_split_hit_t *hits, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (hits[i].led >= RGB_MATRIX_LED_COUNT) continue;
+        // Keep the oldest hits first, so expired ones can be dropped from the front
+        uint16_t tick = hits[i].tick;
+        if (last_hit_buffer.count && last_hit_buffer.tick[last_hit_buffer.count - 1] < tick) {
+            tick = last_hit_buffer.tick[last_hit_buffer.count - 1];
+        }
+        rgb_matrix_add_hit(hits[i].led, tick);
+    }
+}
+#    endif // RGB_MATRIX_SPLIT
+#endif     // RGB_MATRIX_KEYREACTIVE_ENABLED
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -185,21 +356,16 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
+#    ifdef RGB_MATRIX_SPLIT
+    // The master sends the slave every hit on either half, see rgb_matrix_split_add_hits()
+    if (!is_keyboard_master()) led_count = 0;
+#    endif
 
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        rgb_matrix_add_hit(led[i], 0);
+#    ifdef RGB_MATRIX_SPLIT
+        rgb_matrix_split_queue_hit(led[i]);
+#    endif
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -256,15 +422,23 @@ static void rgb_task_timers(void) {
 #endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
     rgb_timer_buffer = sync_timer_read32();
 
-    // Update double buffer last hit timers
+    // Update double buffer last hit timers, dropping hits no effect can show anymore
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
+    uint8_t count   = last_hit_buffer.count;
+    uint8_t expired = 0;
     for (uint8_t i = 0; i < count; ++i) {
         if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
+            expired = i + 1;
             continue;
         }
         last_hit_buffer.tick[i] += deltaTime;
+        if (scale16by8(last_hit_buffer.tick[i], qadd8(rgb_matrix_config.speed, 1)) > RGB_MATRIX_HIT_EXPIRED_TICK) {
+            expired = i + 1;
+        }
+    }
+    // Older hits have larger ticks, so the expired ones are always at the front
+    if (expired) {
+        rgb_matrix_drop_hits(expired);
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
@@ -289,6 +463,49 @@ static void rgb_task_start(void) {
     rgb_task_state = RENDERING;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+static void rgb_task_render_slice(uint8_t effect) {
+    uint8_t first = 0;
+    uint8_t last  = RGB_MATRIX_LED_COUNT;
+#    if defined(RGB_MATRIX_SPLIT)
+    if (is_keyboard_left()) {
+        last = k_rgb_matrix_split[0];
+    } else {
+        first = k_rgb_matrix_split[0];
+    }
+#    endif
+
+    // every effect has its own cost, start over when it changes
+    if (effect != rgb_render_cost_effect) {
+        rgb_render_cost_effect = effect;
+        rgb_render_led_cost    = 0;
+    }
+
+    // fit as many LEDs as the budget allows, the static limit is used until the effect has been measured
+    uint32_t count = RGB_MATRIX_LED_PROCESS_LIMIT;
+    if (rgb_render_led_cost) {
+        count = (uint32_t)RGB_MATRIX_RENDER_BUDGET_US * 16 / rgb_render_led_cost;
+    }
+    if (count < 1) count = 1;
+
+    uint8_t min                     = rgb_effect_params.iter == 0 ? first : rgb_render_limits.led_max_index;
+    rgb_render_limits.led_min_index = min;
+    rgb_render_limits.led_max_index = count < (uint32_t)(last - min) ? min + count : last;
+}
+
+static void rgb_task_render_measure(uint32_t elapsed_us) {
+    uint8_t count = rgb_render_limits.led_max_index - rgb_render_limits.led_min_index;
+    if (count == 0) return;
+
+    uint32_t sample = elapsed_us * 16 / count;
+    if (sample < 1) sample = 1;
+    if (sample > UINT16_MAX) sample = UINT16_MAX;
+
+    // average over a few iterations so a single interrupt does not shrink the slices
+    rgb_render_led_cost = rgb_render_led_cost ? ((uint32_t)rgb_render_led_cost * 3 + sample) / 4 : sample;
+}
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
@@ -297,6 +514,11 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_task_render_slice(effect);
+    uint32_t render_start = PROFILE_TIMESTAMP();
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -346,6 +568,10 @@ static void rgb_task_render(uint8_t effect) {
             return;
     }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_task_render_measure(PROFILE_ELAPSED_US(render_start));
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
     rgb_effect_params.iter++;
 
     // next task
@@ -358,7 +584,25 @@ static void rgb_task_render(uint8_t effect) {
     }
 }
 
+static inline bool rgb_task_flush_pending(void) {
+    return rgb_matrix_driver.flush_pending && rgb_matrix_driver.flush_pending();
+}
+
+static inline void rgb_task_flush_wait(void) {
+    while (rgb_task_flush_pending()) {
+        wait_ms(1);
+    }
+}
+
 static void rgb_task_flush(uint8_t effect) {
+    // drivers flushing in the background take the next frame once the previous one has been sent
+    if (rgb_task_flush_pending()) return;
+
+#ifdef ENABLE_RGB_MATRIX_DIRECT
+    // a host frame started after rendering finished is written straight into the buffers, hold it back until complete
+    if (rgb_matrix_direct_receiving()) return;
+#endif
+
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
@@ -366,6 +610,15 @@ static void rgb_task_flush(uint8_t effect) {
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_fps_frames++;
+    if (timer_elapsed32(rgb_fps_timer) >= 1000) {
+        rgb_fps        = rgb_fps_frames;
+        rgb_fps_frames = 0;
+        rgb_fps_timer  = timer_read32();
+    }
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
     // next task
     rgb_task_state = SYNCING;
 }
@@ -423,31 +676,37 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 }
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    // the slice of the current iteration, sized by rgb_task_render_slice()
+    (void)iter;
+    return rgb_render_limits;
+#else
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
-#    if defined(RGB_MATRIX_SPLIT)
+#    if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#        if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
     if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
     if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
-#    else
+#        else
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
-#    endif
-#else
-#    if defined(RGB_MATRIX_SPLIT)
+#        endif
+#    else
+#        if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = 0;
     limits.led_max_index = RGB_MATRIX_LED_COUNT;
     if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
     if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
-#    else
+#        else
     limits.led_min_index = 0;
     limits.led_max_index = RGB_MATRIX_LED_COUNT;
+#        endif
 #    endif
-#endif
     return limits;
+#endif
 }
 
 __attribute__((weak)) bool rgb_matrix_indicators_advanced_modules(uint8_t led_min, uint8_t led_max) {
@@ -473,9 +732,26 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+void rgb_matrix_update_geometry(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx              = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy              = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_led_geometry[i].dx    = dx;
+        g_led_geometry[i].dy    = dy;
+        g_led_geometry[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_geometry[i].angle = atan2_8(dy, dx);
+    }
+}
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    rgb_matrix_update_geometry();
+#endif
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -500,7 +776,9 @@ void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_MATRIX_SLEEP
     if (state && !suspend_state) { // only run if turning off, and only once
         rgb_task_render(0);        // turn off all LEDs when suspending
-        rgb_task_flush(0);         // and actually flash led state to LEDs
+        rgb_task_flush_wait();
+        rgb_task_flush(0); // and actually flash led state to LEDs
+        rgb_task_flush_wait();
     }
     suspend_state = state;
 #endif
@@ -701,6 +979,12 @@ uint8_t rgb_matrix_get_speed(void) {
     return rgb_matrix_config.speed;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+uint16_t rgb_matrix_get_fps(void) {
+    return rgb_fps;
+}
+#endif
+
 void rgb_matrix_increase_speed_helper(bool write_to_eeprom) {
     rgb_matrix_set_speed_eeprom_helper(qadd8(rgb_matrix_config.speed, RGB_MATRIX_SPD_STEP), write_to_eeprom);
 }
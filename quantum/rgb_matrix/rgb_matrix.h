@@ -158,6 +158,15 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
+#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && defined(RGB_MATRIX_SPLIT)
+// Hits recorded on the master that the slave has not acknowledged yet, oldest first and numbered from first
+uint8_t rgb_matrix_split_get_hits(rgb_matrix_split_hit_t hits[LED_HITS_TO_REMEMBER], uint8_t *first);
+// Forgets the hits numbered before next
+void rgb_matrix_split_hits_acked(uint8_t next);
+// Records hits received from the master
+void rgb_matrix_split_add_hits(const rgb_matrix_split_hit_t *hits, uint8_t count);
+#endif
+
 void rgb_matrix_task(void);
 
 // This runs after another backlight effect and replaces
@@ -171,6 +180,10 @@ bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+// Call after changing g_led_config.point at runtime
+void rgb_matrix_update_geometry(void);
+#endif
 
 void rgb_matrix_reload_from_eeprom(void);
 
@@ -219,6 +232,9 @@ led_flags_t rgb_matrix_get_flags(void);
 void        rgb_matrix_set_flags(led_flags_t flags);
 void        rgb_matrix_set_flags_noeeprom(led_flags_t flags);
 void        rgb_matrix_update_pwm_buffers(void);
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+uint16_t rgb_matrix_get_fps(void);
+#endif
 
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_force_flush_rgb_matrix
@@ -286,3 +302,6 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+extern led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#endif
@@ -0,0 +1,158 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix_direct.h"
+#include "rgb_matrix.h"
+#include "timer.h"
+
+#include <lib/lib8tion/lib8tion.h>
+
+#ifdef ENABLE_RGB_MATRIX_DIRECT
+
+static uint8_t  frame_seq;
+static uint8_t  last_seq;
+static bool     synced;
+static bool     receiving;
+static uint32_t last_report;
+static uint32_t frames;
+static uint32_t dropped;
+
+static inline bool direct_active(void) {
+    return rgb_matrix_is_enabled() && rgb_matrix_get_mode() == RGB_MATRIX_DIRECT && !rgb_matrix_get_suspend_state();
+}
+
+static void abandon_frame(void) {
+    if (receiving) {
+        receiving = false;
+        dropped++;
+    }
+}
+
+bool rgb_matrix_direct_receiving(void) {
+    if (receiving && timer_elapsed32(last_report) >= RGB_MATRIX_DIRECT_TIMEOUT) {
+        abandon_frame();
+    }
+    return receiving;
+}
+
+uint32_t rgb_matrix_direct_frames(void) {
+    return frames;
+}
+
+uint32_t rgb_matrix_direct_dropped_frames(void) {
+    return dropped;
+}
+
+// Writes the runs of a frame report to the driver, false if they do not fit the report or the matrix
+static bool decode_runs(const uint8_t *data, uint8_t length) {
+    uint8_t val = rgb_matrix_get_val();
+    uint8_t pos = 0;
+
+    while (pos + 2 <= length) {
+        uint8_t led    = data[pos];
+        uint8_t count  = data[pos + 1] & RGB_MATRIX_DIRECT_RUN_COUNT;
+        bool    repeat = data[pos + 1] & RGB_MATRIX_DIRECT_RUN_REPEAT;
+        pos += 2;
+
+        if (count == 0) {
+            break;
+        }
+        uint8_t colors = repeat ? 1 : count;
+        if (led + count > RGB_MATRIX_LED_COUNT || pos + colors * 3 > length) {
+            return false;
+        }
+
+        for (uint8_t i = 0; i < count; i++) {
+            const uint8_t *rgb = &data[pos + (repeat ? 0 : i * 3)];
+            rgb_matrix_set_color(led + i, scale8(rgb[0], val), scale8(rgb[1], val), scale8(rgb[2], val));
+        }
+        pos += colors * 3;
+    }
+    return true;
+}
+
+static uint8_t receive_frame(uint8_t seq, uint8_t flags, const uint8_t *runs, uint8_t length) {
+    if (!direct_active()) {
+        abandon_frame();
+        return rgb_matrix_direct_inactive;
+    }
+
+    if (flags & RGB_MATRIX_DIRECT_FRAME_START) {
+        abandon_frame();
+        // Late or repeated frames are dropped whole rather than drawn over newer ones
+        if (synced && (int8_t)(seq - last_seq) <= 0) {
+            dropped++;
+            return rgb_matrix_direct_dropped;
+        }
+        receiving = true;
+        frame_seq = seq;
+    } else if (!receiving || seq != frame_seq) {
+        // The start of this frame was lost or it was abandoned, skip the rest of it
+        if (receiving) {
+            abandon_frame();
+        }
+        return rgb_matrix_direct_dropped;
+    }
+
+    last_report = timer_read32();
+    if (!decode_runs(runs, length)) {
+        abandon_frame();
+        return rgb_matrix_direct_invalid;
+    }
+
+    if (flags & RGB_MATRIX_DIRECT_FRAME_END) {
+        receiving = false;
+        synced    = true;
+        last_seq  = seq;
+        frames++;
+    }
+    return rgb_matrix_direct_ok;
+}
+
+bool rgb_matrix_direct_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, channel_id, direct_command_id, ... ]
+    uint8_t *direct_command_id = &(data[2]);
+
+    switch (*direct_command_id) {
+        case id_rgb_matrix_direct_get_info:
+            // [ ..., status, LED count, last frame, frames (big-endian u32), dropped (big-endian u32) ]
+            data[3]  = direct_active() ? rgb_matrix_direct_ok : rgb_matrix_direct_inactive;
+            data[4]  = RGB_MATRIX_LED_COUNT;
+            data[5]  = last_seq;
+            data[6]  = frames >> 24;
+            data[7]  = frames >> 16;
+            data[8]  = frames >> 8;
+            data[9]  = frames & 0xFF;
+            data[10] = dropped >> 24;
+            data[11] = dropped >> 16;
+            data[12] = dropped >> 8;
+            data[13] = dropped & 0xFF;
+            return true;
+        case id_rgb_matrix_direct_begin:
+            // Switch to the direct effect without saving it, the next frame is accepted whatever its number
+            rgb_matrix_mode_noeeprom(RGB_MATRIX_DIRECT);
+            receiving = false;
+            synced    = false;
+            frames    = 0;
+            dropped   = 0;
+            data[3] = direct_active() ? rgb_matrix_direct_ok : rgb_matrix_direct_inactive;
+            return true;
+        case id_rgb_matrix_direct_frame: {
+            // [ ..., frame number, flags, runs... ], replies with [ ..., status, last frame ]
+            uint8_t seq    = data[3];
+            uint8_t flags  = data[4];
+            uint8_t status = receive_frame(seq, flags, &data[5], length - 5);
+            if (!(flags & RGB_MATRIX_DIRECT_FRAME_ACK)) {
+                return false;
+            }
+            data[3] = status;
+            data[4] = last_seq;
+            return true;
+        }
+        default:
+            *direct_command_id = id_rgb_matrix_direct_unhandled;
+            return true;
+    }
+}
+
+#endif // ENABLE_RGB_MATRIX_DIRECT
@@ -0,0 +1,59 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+    Per-LED colors streamed by the host over raw HID, shown by the DIRECT effect.
+
+    Frames are numbered and may span several reports. Each report carries runs
+    of LEDs that are decoded straight into the driver's color buffer, so the
+    host only has to send the LEDs that changed since its previous frame.
+*/
+
+// Milliseconds without a report after which an incomplete frame is abandoned
+#ifndef RGB_MATRIX_DIRECT_TIMEOUT
+#    define RGB_MATRIX_DIRECT_TIMEOUT 50
+#endif
+
+enum rgb_matrix_direct_command_id {
+    id_rgb_matrix_direct_get_info  = 0x01,
+    id_rgb_matrix_direct_begin     = 0x02,
+    id_rgb_matrix_direct_frame     = 0x03,
+    id_rgb_matrix_direct_unhandled = 0xFF,
+};
+
+enum rgb_matrix_direct_frame_flags {
+    RGB_MATRIX_DIRECT_FRAME_START = 0x01, // first report of a frame
+    RGB_MATRIX_DIRECT_FRAME_END   = 0x02, // last report of a frame
+    RGB_MATRIX_DIRECT_FRAME_ACK   = 0x04, // reply to this report
+};
+
+enum rgb_matrix_direct_status {
+    rgb_matrix_direct_ok       = 0x00,
+    rgb_matrix_direct_dropped  = 0x01,
+    rgb_matrix_direct_inactive = 0x02,
+    rgb_matrix_direct_invalid  = 0x03,
+};
+
+// Each run in a frame report is [ first LED, count | RGB_MATRIX_DIRECT_RUN_REPEAT, colors... ], a zero count ends the report
+#define RGB_MATRIX_DIRECT_RUN_REPEAT 0x80
+#define RGB_MATRIX_DIRECT_RUN_COUNT 0x7F
+
+/**
+ * \brief Whether a frame is partway through being received, and should not be flushed yet.
+ */
+bool rgb_matrix_direct_receiving(void);
+
+uint32_t rgb_matrix_direct_frames(void);
+uint32_t rgb_matrix_direct_dropped_frames(void);
+
+/**
+ * \brief Handle a report on the RGB Matrix direct channel.
+ *
+ * \return true if a reply has been written back into data and should be sent.
+ */
+bool rgb_matrix_direct_raw_hid_receive(uint8_t *data, uint8_t length);
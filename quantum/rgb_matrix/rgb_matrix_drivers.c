@@ -66,6 +66,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush         = is31fl3733_flush,
     .set_color     = is31fl3733_set_color,
     .set_color_all = is31fl3733_set_color_all,
+#    if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+    .flush_pending = is31fl3733_flush_pending,
+#    endif
 };
 
 #elif defined(RGB_MATRIX_IS31FL3736)
@@ -74,6 +77,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush         = is31fl3736_flush,
     .set_color     = is31fl3736_set_color,
     .set_color_all = is31fl3736_set_color_all,
+#    if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+    .flush_pending = is31fl3736_flush_pending,
+#    endif
 };
 
 #elif defined(RGB_MATRIX_IS31FL3737)
@@ -82,6 +88,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush         = is31fl3737_flush,
     .set_color     = is31fl3737_set_color,
     .set_color_all = is31fl3737_set_color_all,
+#    if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+    .flush_pending = is31fl3737_flush_pending,
+#    endif
 };
 
 #elif defined(RGB_MATRIX_IS31FL3741)
@@ -90,6 +99,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush         = is31fl3741_flush,
     .set_color     = is31fl3741_set_color,
     .set_color_all = is31fl3741_set_color_all,
+#    if defined(PROTOCOL_CHIBIOS) && defined(I2C_ASYNC_ENABLE)
+    .flush_pending = is31fl3741_flush_pending,
+#    endif
 };
 
 #elif defined(RGB_MATRIX_IS31FL3742A)
@@ -151,6 +163,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush         = ws2812_flush,
     .set_color     = ws2812_set_color,
     .set_color_all = ws2812_set_color_all,
+#    ifdef WS2812_SPI
+    .flush_pending = ws2812_flush_pending,
+#    endif
 };
 
 #endif
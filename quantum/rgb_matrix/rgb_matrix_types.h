@@ -42,6 +42,12 @@ typedef struct PACKED {
 } last_hit_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+// A hit passed to the other half of a split keyboard, tick is its age in milliseconds
+typedef struct PACKED {
+    uint8_t led;
+    uint8_t tick;
+} rgb_matrix_split_hit_t;
+
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
 typedef uint8_t led_flags_t;
@@ -57,6 +63,14 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+// LED position relative to k_rgb_matrix_center, see RGB_MATRIX_GEOMETRY_CACHE
+typedef struct PACKED {
+    int16_t dx;
+    int16_t dy;
+    uint8_t dist;
+    uint8_t angle;
+} led_geometry_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
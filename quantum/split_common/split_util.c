@@ -33,6 +33,10 @@
 #    include "rgblight.h"
 #endif
 
+#ifdef SPLIT_COMMON_TRANSACTIONS
+#    include "transactions.h"
+#endif
+
 #ifndef SPLIT_USB_TIMEOUT
 #    define SPLIT_USB_TIMEOUT 2000
 #endif
@@ -248,6 +252,12 @@ bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t sl
 
     __attribute__((unused)) bool okay = transport_master(master_matrix, slave_matrix);
 #if SPLIT_MAX_CONNECTION_ERRORS > 0
+#    ifdef SPLIT_COMMON_TRANSACTIONS
+    if (!okay && transactions_backing_off()) {
+        // Transactions waiting to be retried are neither new errors nor a sign the connection is back
+        return is_transport_connected();
+    }
+#    endif // SPLIT_COMMON_TRANSACTIONS
     if (!okay) {
         if (connection_errors < UINT8_MAX) {
             connection_errors++;
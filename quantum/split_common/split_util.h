@@ -13,6 +13,13 @@ void split_post_init(void);
 bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 bool is_transport_connected(void);
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+#    include "keyboard.h"
+
+// Takes the next key event from the slave half, in the order they happened there
+bool split_matrix_event_dequeue(keyevent_t *event);
+#endif // SPLIT_MATRIX_EVENTS_ENABLE
+
 void split_watchdog_update(bool done);
 void split_watchdog_task(void);
 bool split_watchdog_check(void);
@@ -23,8 +23,20 @@ enum serial_transaction_id {
     I2C_EXECUTE_CALLBACK,
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSPORT_BUNDLE
+    // One per frame size, in increasing order, as serial transports send the whole buffer
+    EXECUTE_BUNDLE_READ,
+    EXECUTE_BUNDLE_QUARTER,
+    EXECUTE_BUNDLE_HALF,
+    EXECUTE_BUNDLE_FULL,
+#endif // SPLIT_TRANSPORT_BUNDLE
+
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+    GET_SLAVE_MATRIX_EVENTS,
+#else // SPLIT_MATRIX_EVENTS_ENABLE
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
+#endif // SPLIT_MATRIX_EVENTS_ENABLE
 
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
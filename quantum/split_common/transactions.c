@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <inttypes.h>
 #include <stdint.h>
 #include <string.h>
 #include <stddef.h>
@@ -24,7 +25,6 @@
 #include "host.h"
 #include "action_util.h"
 #include "sync_timer.h"
-#include "wait.h"
 #include "transactions.h"
 #include "transport.h"
 #include "transaction_id_define.h"
@@ -64,6 +64,9 @@
 #ifdef WPM_ENABLE
 #    include "wpm.h"
 #endif
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+#    include "basic_profiling.h"
+#endif
 
 #define SYNC_TIMER_OFFSET 2
 
@@ -71,6 +74,10 @@
 #    define FORCED_SYNC_THROTTLE_MS 100
 #endif // FORCED_SYNC_THROTTLE_MS
 
+#ifndef SPLIT_TRANSACTION_STATS_PRINT_INTERVAL
+#    define SPLIT_TRANSACTION_STATS_PRINT_INTERVAL 10000
+#endif // SPLIT_TRANSACTION_STATS_PRINT_INTERVAL
+
 #define sizeof_member(type, member) sizeof(((type *)NULL)->member)
 
 #define trans_initiator2target_initializer_cb(member, cb) \
@@ -81,12 +88,32 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
+#define trans_exchange_initializer_cb(initiator2target_member, target2initiator_member, cb) \
+    { sizeof_member(split_shared_memory_t, initiator2target_member), offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), cb }
+#define trans_exchange_initializer(initiator2target_member, target2initiator_member) trans_exchange_initializer_cb(initiator2target_member, target2initiator_member, NULL)
+
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+static bool transaction_attempt(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+
+#ifdef SPLIT_TRANSPORT_THREAD
+#    ifdef SPLIT_TRANSPORT_BUNDLE
+#        error "SPLIT_TRANSPORT_THREAD cannot be used with SPLIT_TRANSPORT_BUNDLE, the slave matrix is read from the bundle"
+#    endif // SPLIT_TRANSPORT_BUNDLE
+static bool transaction_threaded(int8_t id);
+#endif // SPLIT_TRANSPORT_THREAD
+
+#ifdef SPLIT_TRANSPORT_BUNDLE
+static bool bundle_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define transaction_execute bundle_execute_transaction
+#else // SPLIT_TRANSPORT_BUNDLE
+#    define transaction_execute transaction_attempt
+#endif // SPLIT_TRANSPORT_BUNDLE
+
+#define transport_write(id, data, length) transaction_execute(id, data, length, NULL, 0)
+#define transport_read(id, data, length) transaction_execute(id, NULL, 0, data, length)
+#define transport_exec(id) transaction_execute(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -95,20 +122,382 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 ////////////////////////////////////////////////////
-// Helpers
+// Retries
+
+// Consecutive failures of each transaction and when the last one happened, it is held back until its backoff has passed
+static uint8_t  transaction_failures[NUM_TOTAL_TRANSACTIONS] = {0};
+static uint16_t transaction_failed_at[NUM_TOTAL_TRANSACTIONS];
+
+typedef struct {
+    bool deferred;
+    bool retrying; // failed while its backoff is still growing
+    bool failed;
+} transaction_flags_t;
+
+// Set by transaction_attempt() while a handler runs, the transport thread keeps its own as it runs alongside the main loop
+static transaction_flags_t transaction_flags[2] = {0};
+static bool                transactions_deferred = false; // for the whole scan
+
+static inline transaction_flags_t *transaction_flags_of(int8_t id) {
+#ifdef SPLIT_TRANSPORT_THREAD
+    return &transaction_flags[transaction_threaded(id)];
+#else
+    return &transaction_flags[0];
+#endif // SPLIT_TRANSPORT_THREAD
+}
 
-static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
-    int num_retries = is_transport_connected() ? 10 : 1;
-    for (int iter = 1; iter <= num_retries; ++iter) {
-        if (iter > 1) {
-            for (int i = 0; i < iter * iter; ++i) {
-                wait_us(10);
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+static split_transaction_stats_t transaction_stats[NUM_TOTAL_TRANSACTIONS] = {0};
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+
+// 1ms after the first failure, doubling with each one after it up to SPLIT_TRANSACTION_BACKOFF_MAX
+static uint16_t transaction_backoff(uint8_t failures) {
+    uint16_t backoff = 1;
+    while (--failures > 0 && backoff < SPLIT_TRANSACTION_BACKOFF_MAX) {
+        backoff <<= 1;
+    }
+    return backoff < SPLIT_TRANSACTION_BACKOFF_MAX ? backoff : SPLIT_TRANSACTION_BACKOFF_MAX;
+}
+
+static bool transaction_attempt(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (transaction_failures[id] > 0 && timer_elapsed(transaction_failed_at[id]) < transaction_backoff(transaction_failures[id])) {
+        // Still backing off, the handler carries on with what it has and this is tried again on a later scan
+        transaction_flags_of(id)->deferred = true;
+        return false;
+    }
+
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+    uint32_t start = PROFILE_TIMESTAMP();
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+    bool okay = transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+    split_transaction_stats_t *stats   = &transaction_stats[id];
+    uint32_t                   latency = PROFILE_ELAPSED_US(start);
+    stats->attempts++;
+    if (!okay) {
+        stats->failures++;
+    }
+    if (latency > stats->worst_latency_us) {
+        stats->worst_latency_us = latency;
+    }
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+
+    if (okay) {
+        transaction_failures[id] = 0;
+    } else {
+        if (transaction_failures[id] < UINT8_MAX) {
+            transaction_failures[id]++;
+        }
+        transaction_failed_at[id] = timer_read();
+        // Only counts against the connection once the backoff has grown to its longest
+        if (transaction_backoff(transaction_failures[id]) < SPLIT_TRANSACTION_BACKOFF_MAX) {
+            transaction_flags_of(id)->retrying = true;
+        } else {
+            transaction_flags_of(id)->failed = true;
+        }
+    }
+    return okay;
+}
+
+// Data came through but did not match its checksum
+static inline void transaction_checksum_mismatch(int8_t id) {
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+    transaction_stats[id].checksum_mismatches++;
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+}
+
+bool transactions_backing_off(void) {
+    return transactions_deferred;
+}
+
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+
+void transaction_get_stats(int8_t transaction_id, split_transaction_stats_t *stats) {
+    *stats = transaction_stats[transaction_id];
+}
+
+void transactions_reset_stats(void) {
+    memset(transaction_stats, 0, sizeof(transaction_stats));
+}
+
+void transactions_print_stats(void) {
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        const split_transaction_stats_t *stats = &transaction_stats[id];
+        if (stats->attempts > 0) {
+            dprintf("split %d: n=%" PRIu32 " failed=%" PRIu32 " checksum=%" PRIu32 " max=%" PRIu32 " us\n", id, stats->attempts, stats->failures, stats->checksum_mismatches, stats->worst_latency_us);
+        }
+    }
+}
+
+static void write_u32(uint8_t *data, uint32_t value) {
+    data[0] = value >> 24;
+    data[1] = value >> 16;
+    data[2] = value >> 8;
+    data[3] = value & 0xFF;
+}
+
+void transactions_stats_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, channel_id, stats_command_id, transaction_id, ... ]
+    uint8_t *stats_command_id = &(data[2]);
+    uint8_t *transaction_id   = &(data[3]);
+
+    switch (*stats_command_id) {
+        case id_split_transaction_stats_get_count:
+            *transaction_id = NUM_TOTAL_TRANSACTIONS;
+            data[4]         = is_transport_connected();
+            break;
+        case id_split_transaction_stats_get: {
+            if (*transaction_id >= NUM_TOTAL_TRANSACTIONS || length < 21) {
+                *stats_command_id = id_split_transaction_stats_unhandled;
+                break;
             }
+            const split_transaction_stats_t *stats = &transaction_stats[*transaction_id];
+            write_u32(&data[4], stats->attempts);
+            write_u32(&data[8], stats->failures);
+            write_u32(&data[12], stats->checksum_mismatches);
+            write_u32(&data[16], stats->worst_latency_us);
+            data[20] = transaction_failures[*transaction_id];
+            break;
+        }
+        case id_split_transaction_stats_reset:
+            transactions_reset_stats();
+            break;
+        default:
+            *stats_command_id = id_split_transaction_stats_unhandled;
+            break;
+    }
+}
+
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+
+////////////////////////////////////////////////////
+// Bundle
+
+#ifdef SPLIT_TRANSPORT_BUNDLE
+
+// Bytes each transaction costs besides its buffers, the id and the slave's handshake on serial
+#    define BUNDLE_TRANSACTION_OVERHEAD 2
+
+// Records each frame size has room for, indexed from EXECUTE_BUNDLE_READ
+static const uint8_t bundle_sizes[] = {0, SPLIT_TRANSPORT_BUNDLE_SIZE / 4, SPLIT_TRANSPORT_BUNDLE_SIZE / 2, SPLIT_TRANSPORT_BUNDLE_SIZE};
+
+// Writes waiting for the next bundle, and the slave data that came back with the last one
+static split_bundle_frame_t bundle_frame   = {0};
+static uint8_t              bundle_records = 0;
+static uint8_t              bundle_reply[sizeof(split_bundle_reply_t)];
+static uint32_t             bundle_replied = 0; // bit n is set while the last bundle's copy of transaction n's slave data is unread
+
+// Slave data read every scan, anything read now and then costs less on its own
+static bool bundle_reads(int8_t id) {
+#    ifdef SPLIT_MATRIX_EVENTS_ENABLE
+    if (id == GET_SLAVE_MATRIX_EVENTS) return true;
+#    else  // SPLIT_MATRIX_EVENTS_ENABLE
+    if (id == GET_SLAVE_MATRIX_CHECKSUM) return true;
+#    endif // SPLIT_MATRIX_EVENTS_ENABLE
+#    ifdef ENCODER_ENABLE
+    if (id == GET_ENCODERS_CHECKSUM) return true;
+#    endif // ENCODER_ENABLE
+    return false;
+}
+
+static bool bundle_writes(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+#    ifdef USE_I2C
+    if (id == I2C_EXECUTE_CALLBACK) return false;
+#    endif // USE_I2C
+#    ifndef DISABLE_SYNC_TIMER
+    // Would be a scan late by the time it got to the slave
+    if (id == PUT_SYNC_TIMER) return false;
+#    endif // DISABLE_SYNC_TIMER
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    // RPC relies on its transactions running in order, right away
+    if (id >= PUT_RPC_INFO && id <= GET_RPC_RESP_DATA) return false;
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    // Exchanges want their reply now, and callback-only transactions act on what has just been read
+    return (id < EXECUTE_BUNDLE_READ || id > EXECUTE_BUNDLE_FULL) && trans->initiator2target_buffer_size > 0 && trans->target2initiator_buffer_size == 0 && 1 + trans->initiator2target_buffer_size <= SPLIT_TRANSPORT_BUNDLE_SIZE;
+}
+
+// Copies the slave data of bundled reads to or from a reply, as far as it fits, returning which were copied
+static uint32_t bundle_reply_copy(uint8_t *reply, bool to_reply) {
+    uint32_t copied = 0;
+    uint16_t pos    = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (!bundle_reads(id)) continue;
+        if (pos + trans->target2initiator_buffer_size > sizeof(split_bundle_reply_t)) break;
+        if (to_reply) {
+            memcpy(&reply[pos], split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+        } else {
+            memcpy(split_trans_target2initiator_buffer(trans), &reply[pos], trans->target2initiator_buffer_size);
+        }
+        pos += trans->target2initiator_buffer_size;
+        copied |= (uint32_t)1 << id;
+    }
+    return copied;
+}
+
+// Sends the queued writes as transactions of their own, keeping them all queued if any fails
+static void bundle_send_each(void) {
+    uint8_t pos = 0;
+    while (pos < bundle_frame.length) {
+        int8_t  id     = bundle_frame.records[pos];
+        uint8_t length = split_transaction_table[id].initiator2target_buffer_size;
+        if (!transaction_attempt(id, &bundle_frame.records[pos + 1], length, NULL, 0)) {
+            return;
+        }
+        pos += 1 + length;
+    }
+    bundle_frame.length = 0;
+    bundle_records      = 0;
+}
+
+static bool bundle_exchange(void) {
+    // The smallest frame holding the queued writes, unless its header and padding cost more than it saves over sending them one by one
+    uint8_t size = 0;
+    while (bundle_frame.length > bundle_sizes[size]) {
+        size++;
+    }
+    if (offsetof(split_bundle_frame_t, records) + bundle_sizes[size] > bundle_frame.length + bundle_records * (BUNDLE_TRANSACTION_OVERHEAD - 1)) {
+        size = 0;
+    }
+
+    bundle_frame.checksum = crc8(&bundle_frame.length, 1 + bundle_frame.length);
+    if (!transaction_attempt(EXECUTE_BUNDLE_READ + size, &bundle_frame, size > 0 ? offsetof(split_bundle_frame_t, records) + bundle_frame.length : 0, bundle_reply, sizeof(bundle_reply))) {
+        // The queued writes go with the next attempt
+        bundle_replied = 0;
+        return false;
+    }
+    bundle_replied = bundle_reply_copy(bundle_reply, false);
+
+    if (size > 0) {
+        bundle_frame.length = 0;
+        bundle_records      = 0;
+    } else {
+        // After the bundle, which may apply an earlier frame that these would otherwise be undone by
+        bundle_send_each();
+    }
+    return true;
+}
+
+static bool bundle_queue(int8_t id, const void *data, uint8_t length) {
+    // A later write replaces the one still queued
+    uint8_t pos = 0;
+    while (pos < bundle_frame.length) {
+        if (bundle_frame.records[pos] == id) {
+            memcpy(&bundle_frame.records[pos + 1], data, length);
+            return true;
+        }
+        pos += 1 + split_transaction_table[bundle_frame.records[pos]].initiator2target_buffer_size;
+    }
+
+    if (bundle_frame.length + 1 + length > SPLIT_TRANSPORT_BUNDLE_SIZE) {
+        // Costs the same as it would without bundles
+        return transaction_attempt(id, data, length, NULL, 0);
+    }
+    bundle_frame.records[bundle_frame.length] = id;
+    memcpy(&bundle_frame.records[bundle_frame.length + 1], data, length);
+    bundle_frame.length += 1 + length;
+    bundle_records++;
+    return true;
+}
+
+static bool bundle_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+
+    if (bundle_reads(id)) {
+        // The first read of a scan fetches a new reply, sending the writes queued since the last one
+        if (!(bundle_replied & ((uint32_t)1 << id)) && !bundle_exchange()) {
+            return false;
+        }
+        if (!(bundle_replied & ((uint32_t)1 << id))) {
+            // No room for it in the reply
+            return transaction_attempt(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+        }
+        bundle_replied &= ~((uint32_t)1 << id);
+
+        uint8_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+        return true;
+    }
+
+    if (!bundle_writes(id) || initiator2target_length < trans->initiator2target_buffer_size || target2initiator_length > 0) {
+        return transaction_attempt(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    }
+
+    if (!bundle_queue(id, initiator2target_buf, trans->initiator2target_buffer_size)) {
+        return false;
+    }
+    // Kept locally like any other write, for the handlers comparing against what was sent
+    memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, trans->initiator2target_buffer_size);
+    return true;
+}
+
+static void bundle_handlers_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // The frame of every size shares one buffer. On some transports the frame arrives after this runs, so this may
+    // well be the one from the previous bundle, which is why it is checked and applied once whatever size this is.
+    split_bundle_frame_t *frame = (split_bundle_frame_t *)split_trans_initiator2target_buffer(&split_transaction_table[EXECUTE_BUNDLE_FULL]);
+
+    bool    valid = frame->length <= SPLIT_TRANSPORT_BUNDLE_SIZE && frame->checksum == crc8(&frame->length, 1 + frame->length);
+    uint8_t pos   = 0;
+    while (valid && pos < frame->length) {
+        int8_t id = frame->records[pos++];
+        if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS || !bundle_writes(id)) {
+            break;
+        }
+
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (pos + trans->initiator2target_buffer_size > frame->length) {
+            break;
+        }
+        memcpy(split_trans_initiator2target_buffer(trans), &frame->records[pos], trans->initiator2target_buffer_size);
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
         }
-        bool this_okay = true;
-        this_okay      = handler(master_matrix, slave_matrix);
-        if (this_okay) return true;
+        pos += trans->initiator2target_buffer_size;
+    }
+    frame->length = UINT8_MAX;
+
+    bundle_reply_copy((uint8_t *)target2initiator_buffer, true);
+}
+
+// clang-format off
+#    define trans_bundle_initializer(size) \
+    { (size) ? offsetof(split_bundle_frame_t, records) + (size) : 0, offsetof(split_shared_memory_t, bundle_frame), sizeof_member(split_shared_memory_t, bundle_reply), offsetof(split_shared_memory_t, bundle_reply), bundle_handlers_slave_callback }
+#    define TRANSACTIONS_BUNDLE_REGISTRATIONS \
+    [EXECUTE_BUNDLE_READ]    = trans_bundle_initializer(0), \
+    [EXECUTE_BUNDLE_QUARTER] = trans_bundle_initializer(SPLIT_TRANSPORT_BUNDLE_SIZE / 4), \
+    [EXECUTE_BUNDLE_HALF]    = trans_bundle_initializer(SPLIT_TRANSPORT_BUNDLE_SIZE / 2), \
+    [EXECUTE_BUNDLE_FULL]    = trans_bundle_initializer(SPLIT_TRANSPORT_BUNDLE_SIZE),
+// clang-format on
+
+#else // SPLIT_TRANSPORT_BUNDLE
+
+#    define TRANSACTIONS_BUNDLE_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_BUNDLE
+
+////////////////////////////////////////////////////
+// Helpers
+
+static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
+    // Failed transactions are retried on a later scan rather than by waiting here
+    transaction_flags_t *flags = &transaction_flags[0];
+    flags->deferred            = false;
+    flags->retrying            = false;
+    flags->failed              = false;
+    if (handler(master_matrix, slave_matrix)) return true;
+    if (flags->deferred && !flags->retrying && !flags->failed) {
+        // Only held back by its backoff, the handlers after it still get their turn
+        transactions_deferred = true;
+        return true;
+    }
+    if (flags->retrying && !flags->failed) {
+        // Ends the scan, but is not a connection error yet
+        transactions_deferred = true;
+        dprintf("Retrying %s\n", prefix);
+        return false;
     }
+    transactions_deferred = false;
     dprintf("Failed to execute %s\n", prefix);
     return false;
 }
@@ -149,7 +538,10 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
         okay &= transport_read(trans_id_retrieve, destination, length);
-        okay &= curr_checksum == crc8(equiv_shmem, length);
+        if (okay && curr_checksum != crc8(equiv_shmem, length)) {
+            transaction_checksum_mismatch(trans_id_retrieve);
+            okay = false;
+        }
         if (okay) {
             *last_update = timer_read32();
         }
@@ -178,6 +570,97 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+
+// Slave key events waiting for matrix_task(), with their time converted to the master timer. Each count has only
+// one writer, so the handler may run on the transport thread while matrix_task() takes events.
+static keyevent_t slave_matrix_events[SPLIT_MATRIX_EVENTS_QUEUE_SIZE];
+static uint8_t    slave_matrix_events_added = 0;
+static uint8_t    slave_matrix_events_taken = 0;
+
+bool split_matrix_event_dequeue(keyevent_t *event) {
+    uint8_t taken = slave_matrix_events_taken;
+    if (taken == __atomic_load_n(&slave_matrix_events_added, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    *event = slave_matrix_events[taken % SPLIT_MATRIX_EVENTS_QUEUE_SIZE];
+    __atomic_store_n(&slave_matrix_events_taken, taken + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static void slave_matrix_event_enqueue(keyevent_t event) {
+    uint8_t added = slave_matrix_events_added;
+    // Once full, the matrix comparison in matrix_task() picks up the rest, without their timing
+    if ((uint8_t)(added - __atomic_load_n(&slave_matrix_events_taken, __ATOMIC_ACQUIRE)) == SPLIT_MATRIX_EVENTS_QUEUE_SIZE) {
+        return;
+    }
+    slave_matrix_events[added % SPLIT_MATRIX_EVENTS_QUEUE_SIZE] = event;
+    __atomic_store_n(&slave_matrix_events_added, added + 1, __ATOMIC_RELEASE);
+}
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // matrix after the last event taken
+    static uint8_t      taken                          = 0;
+    static bool         synced                         = false;
+    split_slave_matrix_sync_t sync;
+
+    bool okay = transport_read(GET_SLAVE_MATRIX_EVENTS, &sync, sizeof(sync));
+    if (okay && sync.checksum != crc8(&sync.pushed, sizeof(sync) - offsetof(split_slave_matrix_sync_t, pushed))) {
+        transaction_checksum_mismatch(GET_SLAVE_MATRIX_EVENTS);
+        okay = false;
+    }
+    if (okay) {
+        uint8_t fresh = sync.pushed - taken;
+        if (synced && fresh <= SPLIT_MATRIX_EVENTS_QUEUE_SIZE) {
+            // The same as thatHand, which custom matrices do not have
+            uint8_t  slave_rows = isLeftHand ? (MATRIX_ROWS) / 2 : 0;
+            uint16_t now        = timer_read();
+            for (uint8_t i = 0; i < fresh; i++) {
+                const split_matrix_event_t *slave_event = &sync.events[(uint8_t)(taken + i) % SPLIT_MATRIX_EVENTS_QUEUE_SIZE];
+
+                keyevent_t event = MAKE_KEYEVENT(slave_rows + slave_event->row, slave_event->col & ~SPLIT_MATRIX_EVENT_PRESSED, slave_event->col & SPLIT_MATRIX_EVENT_PRESSED);
+                event.time       = now - (uint16_t)(sync.now - slave_event->time);
+                slave_matrix_event_enqueue(event);
+            }
+        }
+        // Otherwise events were missed, and the matrix comparison takes over
+        taken  = sync.pushed;
+        synced = true;
+        memcpy(last_matrix, sync.matrix, sizeof(last_matrix));
+    }
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_slave_matrix_sync_t *sync = &split_shmem->smatrix;
+
+    sync->now = timer_read();
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        matrix_row_t row_changes = sync->matrix[row] ^ slave_matrix[row];
+        for (uint8_t col = 0; row_changes; col++, row_changes >>= 1) {
+            if (row_changes & 1) {
+                split_matrix_event_t *event = &sync->events[sync->pushed % SPLIT_MATRIX_EVENTS_QUEUE_SIZE];
+                event->row                  = row;
+                event->col                  = col | ((slave_matrix[row] >> col) & 1 ? SPLIT_MATRIX_EVENT_PRESSED : 0);
+                event->time                 = sync->now;
+                sync->pushed++;
+            }
+        }
+    }
+    memcpy(sync->matrix, slave_matrix, sizeof(sync->matrix));
+    sync->checksum = crc8(&sync->pushed, sizeof(*sync) - offsetof(split_slave_matrix_sync_t, pushed));
+}
+
+// clang-format off
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+    [GET_SLAVE_MATRIX_EVENTS] = trans_target2initiator_initializer(smatrix),
+// clang-format on
+
+#else // SPLIT_MATRIX_EVENTS_ENABLE
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -199,13 +682,83 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_MATRIX_EVENTS_ENABLE
+
+#ifdef SPLIT_TRANSPORT_THREAD
+
+// Slave matrix reads done on the transport thread, one after another as each scan asks for the next. Each one fills
+// the copy not last published, which may be the one the main loop is still taking, so it checks and takes it again.
+typedef struct {
+    matrix_row_t        matrix[(MATRIX_ROWS) / 2];
+    bool                okay;
+    transaction_flags_t flags;
+} slave_matrix_read_t;
+
+static slave_matrix_read_t slave_matrix_reads[2]        = {0};
+static uint8_t             slave_matrix_reads_published = 0;
+
+static bool transaction_threaded(int8_t id) {
+#    ifdef SPLIT_MATRIX_EVENTS_ENABLE
+    return id == GET_SLAVE_MATRIX_EVENTS;
+#    else  // SPLIT_MATRIX_EVENTS_ENABLE
+    return id == GET_SLAVE_MATRIX_CHECKSUM || id == GET_SLAVE_MATRIX_DATA;
+#    endif // SPLIT_MATRIX_EVENTS_ENABLE
+}
+
+static void slave_matrix_read_task(void) {
+    uint8_t              published = slave_matrix_reads_published;
+    slave_matrix_read_t *read      = &slave_matrix_reads[(published + 1) & 1];
+    transaction_flags_t *flags     = &transaction_flags[1];
+
+    flags->deferred = false;
+    flags->retrying = false;
+    flags->failed   = false;
+    read->okay      = slave_matrix_handlers_master(NULL, read->matrix);
+    read->flags     = *flags;
+    __atomic_store_n(&slave_matrix_reads_published, published + 1, __ATOMIC_RELEASE);
+}
+
+// Takes the newest read and starts the next one, so the main loop does not wait for the slave
+static bool slave_matrix_thread_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t      taken = 0;
+    uint8_t             published;
+    slave_matrix_read_t read;
+    do {
+        published = __atomic_load_n(&slave_matrix_reads_published, __ATOMIC_ACQUIRE);
+        memcpy(&read, &slave_matrix_reads[published & 1], sizeof(read));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        // The copy was reused for another read while this one was being taken
+    } while (published != __atomic_load_n(&slave_matrix_reads_published, __ATOMIC_ACQUIRE));
+
+    split_transport_thread_run(slave_matrix_read_task);
+
+    // Failed reads keep the last good matrix
+    memcpy(slave_matrix, read.matrix, sizeof(read.matrix));
+    if (published == taken) {
+        // Nothing new yet, which neither counts against the connection nor confirms it
+        transaction_flags[0].deferred = true;
+        return false;
+    }
+    taken = published;
+    if (!read.okay) {
+        // Judged as if the read had been done here
+        transaction_flags[0] = read.flags;
+    }
+    return read.okay;
+}
+
+#    undef TRANSACTIONS_SLAVE_MATRIX_MASTER
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix_thread)
+
+#endif // SPLIT_TRANSPORT_THREAD
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -575,25 +1128,131 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t   last_update = 0;
-    rgb_matrix_sync_t rgb_matrix_sync;
-    memcpy(&rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
-    rgb_matrix_sync.rgb_suspend_state = rgb_matrix_get_suspend_state();
-    return send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
+    // Bytes are sent relative to the last state the slave acknowledged, so a lost message is made up for by the next one
+    static rgb_matrix_sync_state_t acked_state;
+    static rgb_matrix_sync_state_t sent_state;
+    static uint8_t                 acked_seq   = 0;
+    static uint8_t                 sent_seq    = 0;
+    static uint8_t                 sent_base   = 0;
+    static uint32_t                last_update = 0;
+
+    rgb_matrix_sync_state_t state;
+    memcpy(&state.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
+    state.rgb_suspend_state = rgb_matrix_get_suspend_state();
+
+    // A new message when the state changes, or when the slave has lost the one the pending message builds on
+    if (sent_seq == 0 || (sent_seq != acked_seq && sent_base != acked_seq) || memcmp(&state, &sent_state, sizeof(state)) != 0) {
+        do {
+            sent_seq = sent_seq == UINT8_MAX ? 1 : sent_seq + 1;
+        } while (sent_seq == acked_seq);
+        sent_base  = acked_seq;
+        sent_state = state;
+    }
+
+    rgb_matrix_sync_t sync   = {.seq = sent_seq, .base = sent_base};
+    uint8_t           length = 0;
+    for (uint8_t i = 0; i < sizeof(state); i++) {
+        uint8_t value = ((uint8_t *)&state)[i];
+        if (sync.base == 0 || value != ((uint8_t *)&acked_state)[i]) {
+            sync.changed |= 1 << i;
+            sync.data[length++] = value;
+        }
+    }
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    rgb_matrix_split_hit_t hits[LED_HITS_TO_REMEMBER];
+    sync.hit_count = rgb_matrix_split_get_hits(hits, &sync.first_hit);
+    if (sync.hit_count > RGB_MATRIX_SYNC_HITS) {
+        sync.hit_count = RGB_MATRIX_SYNC_HITS;
+    }
+    memcpy(&sync.data[length], hits, sync.hit_count * sizeof(rgb_matrix_split_hit_t));
+    length += sync.hit_count * sizeof(rgb_matrix_split_hit_t);
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+    // Still checked in on now and then, in case the slave has restarted
+    if (sent_seq == acked_seq && !sync.hit_count && timer_elapsed32(last_update) < FORCED_SYNC_THROTTLE_MS) {
+        return true;
+    }
+
+    rgb_matrix_sync_ack_t ack;
+    if (!transaction_execute(PUT_RGB_MATRIX, &sync, offsetof(rgb_matrix_sync_t, data) + length, &ack, sizeof(ack))) {
+        return false;
+    }
+    last_update = timer_read32();
+
+    // The slave applies messages in its own loop, so the acknowledgement usually trails by a transaction
+    if (ack.seq == sent_seq) {
+        acked_state = sent_state;
+        acked_seq   = sent_seq;
+    } else if (ack.seq != acked_seq) {
+        // The slave no longer has the state the changes are relative to, send all of it
+        acked_seq = 0;
+    }
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    rgb_matrix_split_hits_acked(ack.next_hit);
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    return true;
 }
 
 static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // The reply doubles as the slave's own record of what it has applied, so a restart clears both together
+    rgb_matrix_sync_t     sync;
+    rgb_matrix_sync_ack_t ack;
     split_shared_memory_lock();
-    memcpy(&rgb_matrix_config, &split_shmem->rgb_matrix_sync.rgb_matrix, sizeof(rgb_config_t));
-    bool rgb_suspend_state = split_shmem->rgb_matrix_sync.rgb_suspend_state;
+    memcpy(&sync, &split_shmem->rgb_matrix_sync, sizeof(sync));
+    memcpy(&ack, &split_shmem->rgb_matrix_sync_ack, sizeof(ack));
     split_shared_memory_unlock();
 
-    rgb_matrix_set_suspend_state(rgb_suspend_state);
+    if (sync.seq == 0) {
+        // Nothing received yet
+        return;
+    }
+
+    // Messages are cumulative, only the newest one counts and only if it builds on the state already applied
+    bool                    apply = sync.seq != ack.seq && (sync.base == 0 || sync.base == ack.seq);
+    rgb_matrix_sync_state_t state;
+    memcpy(&state.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
+    state.rgb_suspend_state = rgb_matrix_get_suspend_state();
+    uint8_t length          = 0;
+    for (uint8_t i = 0; i < sizeof(state); i++) {
+        if (sync.changed & (1 << i)) {
+            ((uint8_t *)&state)[i] = sync.data[length++];
+        }
+    }
+    if (apply) {
+        memcpy(&rgb_matrix_config, &state.rgb_matrix, sizeof(rgb_config_t));
+        rgb_matrix_set_suspend_state(state.rgb_suspend_state);
+    }
+
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    // Hits wait for a state to be applied after starting up, they are sent until acknowledged anyway
+    if (apply || ack.seq != 0) {
+        // A whole state follows a restart of either half, when the hit numbers may have started over
+        bool                          hits_synced = !(apply && sync.base == 0);
+        const rgb_matrix_split_hit_t *hits        = (const rgb_matrix_split_hit_t *)&sync.data[length];
+        uint8_t                       count       = sync.hit_count < RGB_MATRIX_SYNC_HITS ? sync.hit_count : RGB_MATRIX_SYNC_HITS;
+        // Hits are sent until acknowledged, skip those already recorded. The master may also have dropped some before sending them.
+        int8_t  behind = ack.next_hit - sync.first_hit;
+        uint8_t skip   = hits_synced && behind > 0 ? behind : 0;
+        if (skip < count) {
+            rgb_matrix_split_add_hits(&hits[skip], count - skip);
+        }
+        if (!hits_synced || skip <= count) {
+            ack.next_hit = sync.first_hit + count;
+        }
+    }
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    if (apply) {
+        ack.seq = sync.seq;
+    }
+
+    split_shared_memory_lock();
+    memcpy(&split_shmem->rgb_matrix_sync_ack, &ack, sizeof(ack));
+    split_shared_memory_unlock();
 }
 
 #    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_exchange_initializer(rgb_matrix_sync, rgb_matrix_sync_ack),
 
 #else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -925,6 +1584,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // USE_I2C
 
     // clang-format off
+    TRANSACTIONS_BUNDLE_REGISTRATIONS
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
@@ -955,6 +1615,15 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#if defined(SPLIT_TRANSACTION_STATS_ENABLE) && SPLIT_TRANSACTION_STATS_PRINT_INTERVAL > 0
+    static uint32_t print_timer = 0;
+    if (debug_enable && timer_elapsed32(print_timer) >= SPLIT_TRANSACTION_STATS_PRINT_INTERVAL) {
+        print_timer = timer_read32();
+        transactions_print_stats();
+    }
+#endif // defined(SPLIT_TRANSACTION_STATS_ENABLE) && SPLIT_TRANSACTION_STATS_PRINT_INTERVAL > 0
+
+    transactions_deferred = false;
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -974,7 +1643,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
-    return true;
+    return !transactions_deferred;
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
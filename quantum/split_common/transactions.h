@@ -23,6 +23,11 @@
 #include "transaction_id_define.h"
 #include "transport.h"
 
+// Longest a failed transaction is held back before it is attempted again, in milliseconds
+#ifndef SPLIT_TRANSACTION_BACKOFF_MAX
+#    define SPLIT_TRANSACTION_BACKOFF_MAX 16
+#endif // SPLIT_TRANSACTION_BACKOFF_MAX
+
 typedef void (*slave_callback_t)(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 
 // Split transaction Descriptor
@@ -45,6 +50,31 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
+// true if the last transactions_master() only returned false because of transactions held back or failing before their backoff reached its longest
+bool transactions_backing_off(void);
+
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+typedef struct {
+    uint32_t attempts;
+    uint32_t failures;
+    uint32_t checksum_mismatches;
+    uint32_t worst_latency_us;
+} split_transaction_stats_t;
+
+enum split_transaction_stats_command_id {
+    id_split_transaction_stats_get_count = 0x01,
+    id_split_transaction_stats_get       = 0x02,
+    id_split_transaction_stats_reset     = 0x03,
+    id_split_transaction_stats_unhandled = 0xFF,
+};
+
+void transaction_get_stats(int8_t transaction_id, split_transaction_stats_t *stats);
+void transactions_reset_stats(void);
+void transactions_print_stats(void);
+
+void transactions_stats_raw_hid_receive(uint8_t *data, uint8_t length);
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
@@ -22,6 +22,7 @@
 #include "transport.h"
 #include "transaction_id_define.h"
 #include "atomic_util.h"
+#include "synchronization_util.h"
 
 #ifdef USE_I2C
 
@@ -61,6 +62,9 @@ i2c_status_t transport_trigger_callback(int8_t id) {
 }
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    // The write, the callback trigger and the read are one transaction, the split transport thread must not run its own in between
+    split_shared_memory_lock_autounlock();
+
     i2c_status_t              status;
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
@@ -19,6 +19,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "compiler_support.h"
+#include "util.h"
 #include "progmem.h"
 #include "action_layer.h"
 #include "matrix.h"
@@ -52,10 +54,34 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #    include "rgblight.h"
 #endif // RGBLIGHT_ENABLE
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+#    ifndef SPLIT_MATRIX_EVENTS_QUEUE_SIZE
+#        define SPLIT_MATRIX_EVENTS_QUEUE_SIZE 8
+#    endif // SPLIT_MATRIX_EVENTS_QUEUE_SIZE
+
+#    define SPLIT_MATRIX_EVENT_PRESSED 0x80
+
+typedef struct PACKED _split_matrix_event_t {
+    uint8_t  row;
+    uint8_t  col;  // with SPLIT_MATRIX_EVENT_PRESSED set when the key went down
+    uint16_t time; // slave timer when the change came out of debounce
+} split_matrix_event_t;
+
+typedef struct PACKED _split_slave_matrix_sync_t {
+    uint8_t              checksum;
+    uint8_t              pushed; // events so far, the newest SPLIT_MATRIX_EVENTS_QUEUE_SIZE of them are in events
+    uint16_t             now;    // slave timer when this was last updated
+    matrix_row_t         matrix[(MATRIX_ROWS) / 2];
+    split_matrix_event_t events[SPLIT_MATRIX_EVENTS_QUEUE_SIZE];
+} split_slave_matrix_sync_t;
+
+STATIC_ASSERT((SPLIT_MATRIX_EVENTS_QUEUE_SIZE & (SPLIT_MATRIX_EVENTS_QUEUE_SIZE - 1)) == 0 && SPLIT_MATRIX_EVENTS_QUEUE_SIZE <= 32, "SPLIT_MATRIX_EVENTS_QUEUE_SIZE must be a power of two no larger than 32");
+#else // SPLIT_MATRIX_EVENTS_ENABLE
 typedef struct _split_slave_matrix_sync_t {
     uint8_t      checksum;
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
+#endif // SPLIT_MATRIX_EVENTS_ENABLE
 
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
@@ -89,10 +115,38 @@ typedef struct _led_matrix_sync_t {
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 #    include "rgb_matrix.h"
 
-typedef struct _rgb_matrix_sync_t {
+// State mirrored to the slave, sent a byte at a time as it changes
+typedef struct PACKED _rgb_matrix_sync_state_t {
     rgb_config_t rgb_matrix;
     bool         rgb_suspend_state;
+} rgb_matrix_sync_state_t;
+
+// Most hits sent in one message, any more wait for the next one
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#        ifndef RGB_MATRIX_SPLIT_SYNC_HITS
+#            define RGB_MATRIX_SPLIT_SYNC_HITS 4
+#        endif
+#        define RGB_MATRIX_SYNC_HITS (RGB_MATRIX_SPLIT_SYNC_HITS < LED_HITS_TO_REMEMBER ? RGB_MATRIX_SPLIT_SYNC_HITS : LED_HITS_TO_REMEMBER)
+#    else
+#        define RGB_MATRIX_SYNC_HITS 0
+#    endif
+
+// Message numbers are never 0, which stands for no state at all
+typedef struct PACKED _rgb_matrix_sync_t {
+    uint8_t  seq;       // changes whenever the message content does
+    uint8_t  base;      // message the changed bytes are relative to, 0 when every byte is sent
+    uint16_t changed;   // bit n is set when byte n of rgb_matrix_sync_state_t is in data
+    uint8_t  first_hit; // running number of the first hit in data
+    uint8_t  hit_count; // hits in data after the changed bytes
+    uint8_t  data[sizeof(rgb_matrix_sync_state_t) + RGB_MATRIX_SYNC_HITS * sizeof(rgb_matrix_split_hit_t)];
 } rgb_matrix_sync_t;
+
+typedef struct PACKED _rgb_matrix_sync_ack_t {
+    uint8_t seq;      // last message applied by the slave
+    uint8_t next_hit; // running number of the next hit the slave expects
+} rgb_matrix_sync_ack_t;
+
+STATIC_ASSERT(sizeof(rgb_matrix_sync_state_t) <= 16, "rgb_matrix_sync_t changed bits out of range");
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #ifdef SPLIT_MODS_ENABLE
@@ -147,11 +201,44 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSPORT_BUNDLE
+#    ifndef SPLIT_TRANSPORT_BUNDLE_SIZE
+#        define SPLIT_TRANSPORT_BUNDLE_SIZE 32
+#    endif // SPLIT_TRANSPORT_BUNDLE_SIZE
+
+// Writes sent together, each record is [ transaction id, data... ] with as much data as the transaction's buffer holds
+typedef struct _split_bundle_frame_t {
+    uint8_t checksum; // of length and the records
+    uint8_t length;
+    uint8_t records[SPLIT_TRANSPORT_BUNDLE_SIZE];
+} split_bundle_frame_t;
+
+// The slave data read every scan, sent back with each bundle in transaction id order
+typedef struct _split_bundle_reply_t {
+#    ifdef SPLIT_MATRIX_EVENTS_ENABLE
+    split_slave_matrix_sync_t smatrix;
+#    else  // SPLIT_MATRIX_EVENTS_ENABLE
+    uint8_t smatrix_checksum;
+#    endif // SPLIT_MATRIX_EVENTS_ENABLE
+#    ifdef ENCODER_ENABLE
+    uint8_t encoders_checksum;
+#    endif // ENCODER_ENABLE
+} split_bundle_reply_t;
+
+STATIC_ASSERT(sizeof(split_bundle_frame_t) <= UINT8_MAX, "SPLIT_TRANSPORT_BUNDLE_SIZE too large");
+STATIC_ASSERT(sizeof(split_bundle_reply_t) <= UINT8_MAX, "split_bundle_reply_t too large for one transaction");
+#endif // SPLIT_TRANSPORT_BUNDLE
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSPORT_BUNDLE
+    split_bundle_frame_t bundle_frame;
+    uint8_t              bundle_reply[sizeof(split_bundle_reply_t)];
+#endif // SPLIT_TRANSPORT_BUNDLE
+
     split_slave_matrix_sync_t smatrix;
 
 #ifdef SPLIT_TRANSPORT_MIRROR
@@ -191,7 +278,8 @@ typedef struct _split_shared_memory_t {
 #endif // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
-    rgb_matrix_sync_t rgb_matrix_sync;
+    rgb_matrix_sync_t     rgb_matrix_sync;
+    rgb_matrix_sync_ack_t rgb_matrix_sync_ack;
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
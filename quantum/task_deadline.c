@@ -0,0 +1,40 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "task_deadline.h"
+#include "compiler_support.h"
+#include "timer.h"
+
+STATIC_ASSERT(TASK_DEADLINE_COUNT <= 8, "task_deadline bitmasks are 8 bits wide");
+
+#define TASK_BIT(task) ((uint8_t)1 << (task))
+
+// Every task runs once after boot
+static uint8_t  task_woken = (uint8_t)((1 << TASK_DEADLINE_COUNT) - 1);
+static uint8_t  task_armed = 0;
+static uint32_t task_deadlines[TASK_DEADLINE_COUNT];
+
+void task_deadline_wake_all(void) {
+    task_woken = (uint8_t)((1 << TASK_DEADLINE_COUNT) - 1);
+}
+
+void task_deadline_wake(task_deadline_t task) {
+    task_woken |= TASK_BIT(task);
+}
+
+void task_deadline_in(task_deadline_t task, uint32_t delay_ms) {
+    task_deadlines[task] = timer_read32() + delay_ms;
+    task_armed |= TASK_BIT(task);
+}
+
+void task_deadline_clear(task_deadline_t task) {
+    task_armed &= ~TASK_BIT(task);
+}
+
+bool task_deadline_due(task_deadline_t task) {
+    if (task_woken & TASK_BIT(task)) {
+        task_woken &= ~TASK_BIT(task);
+        return true;
+    }
+    return (task_armed & TASK_BIT(task)) && timer_expired32(timer_read32(), task_deadlines[task]);
+}
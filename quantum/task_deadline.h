@@ -0,0 +1,53 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Timeout driven tasks run by quantum_task()
+ *
+ * Rather than polling these tasks on every pass of the main loop, quantum_task() only
+ * calls them once they are due. A task is due after it has been woken, which happens
+ * on every key event and from the feature APIs that start a timer, or once the deadline
+ * it registered has passed. Whenever a task runs it either registers its next deadline
+ * with task_deadline_in() or, when it has nothing left to time, calls task_deadline_clear().
+ */
+typedef enum {
+    TASK_DEADLINE_TAP_DANCE,
+    TASK_DEADLINE_COMBO,
+    TASK_DEADLINE_LEADER,
+    TASK_DEADLINE_KEY_OVERRIDE,
+    TASK_DEADLINE_CAPS_WORD,
+    TASK_DEADLINE_LAYER_LOCK,
+    TASK_DEADLINE_COUNT,
+} task_deadline_t;
+
+/**
+ * @brief Make every task due, for example after a key event changed their state
+ */
+void task_deadline_wake_all(void);
+
+/**
+ * @brief Make a single task due
+ */
+void task_deadline_wake(task_deadline_t task);
+
+/**
+ * @brief Make a task due once `delay_ms` milliseconds have passed
+ */
+void task_deadline_in(task_deadline_t task, uint32_t delay_ms);
+
+/**
+ * @brief Stop running a task until it is woken again
+ */
+void task_deadline_clear(task_deadline_t task);
+
+/**
+ * @brief Check whether a task should run now
+ *
+ * Consumes a pending wake up, the task is expected to register its next deadline.
+ */
+bool task_deadline_due(task_deadline_t task);
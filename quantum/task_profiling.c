@@ -0,0 +1,248 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <inttypes.h>
+#include <string.h>
+#include "task_profiling.h"
+#include "basic_profiling.h"
+#include "timer.h"
+#include "debug.h"
+#include "print.h"
+#include "util.h"
+
+typedef struct {
+    uint32_t samples;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint16_t buckets[TASK_PROFILING_BUCKETS];
+} task_profiling_histogram_t;
+
+static task_profiling_histogram_t histograms[TASK_PROFILING_STAGE_COUNT];
+
+static uint32_t start_timestamp;
+static uint32_t mark_timestamp;
+#if TASK_PROFILING_PRINT_INTERVAL > 0
+static uint32_t print_timer;
+#endif
+
+static const char *const stage_names[TASK_PROFILING_STAGE_COUNT] = {
+    [TASK_PROFILING_MATRIX]  = "matrix",
+    [TASK_PROFILING_QUANTUM] = "quantum",
+#ifdef SPLIT_WATCHDOG_ENABLE
+    [TASK_PROFILING_SPLIT_WATCHDOG] = "split_watchdog",
+#endif
+#ifdef RGBLIGHT_ENABLE
+    [TASK_PROFILING_RGBLIGHT] = "rgblight",
+#endif
+#ifdef LED_MATRIX_ENABLE
+    [TASK_PROFILING_LED_MATRIX] = "led_matrix",
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    [TASK_PROFILING_RGB_MATRIX] = "rgb_matrix",
+#endif
+#ifdef BACKLIGHT_ENABLE
+    [TASK_PROFILING_BACKLIGHT] = "backlight",
+#endif
+#ifdef ENCODER_ENABLE
+    [TASK_PROFILING_ENCODER] = "encoder",
+#endif
+#ifdef POINTING_DEVICE_ENABLE
+    [TASK_PROFILING_POINTING_DEVICE] = "pointing_device",
+#endif
+#ifdef OLED_ENABLE
+    [TASK_PROFILING_OLED] = "oled",
+#endif
+#ifdef ST7565_ENABLE
+    [TASK_PROFILING_ST7565] = "st7565",
+#endif
+#ifdef MOUSEKEY_ENABLE
+    [TASK_PROFILING_MOUSEKEY] = "mousekey",
+#endif
+#ifdef PS2_MOUSE_ENABLE
+    [TASK_PROFILING_PS2_MOUSE] = "ps2_mouse",
+#endif
+#ifdef MIDI_ENABLE
+    [TASK_PROFILING_MIDI] = "midi",
+#endif
+#ifdef JOYSTICK_ENABLE
+    [TASK_PROFILING_JOYSTICK] = "joystick",
+#endif
+#ifdef BATTERY_DRIVER
+    [TASK_PROFILING_BATTERY] = "battery",
+#endif
+#ifdef BLUETOOTH_ENABLE
+    [TASK_PROFILING_BLUETOOTH] = "bluetooth",
+#endif
+#ifdef HAPTIC_ENABLE
+    [TASK_PROFILING_HAPTIC] = "haptic",
+#endif
+    [TASK_PROFILING_LED] = "led",
+#ifdef OS_DETECTION_ENABLE
+    [TASK_PROFILING_OS_DETECTION] = "os_detection",
+#endif
+    [TASK_PROFILING_KEYBOARD_TASK] = "keyboard_task",
+};
+
+/* Buckets 0-3 hold exact values, above that every power of two is split in two halves:
+ * 4-5, 6-7, 8-11, 12-15, 16-23, 24-31, ... The last bucket collects everything larger. */
+static uint8_t bucket_for(uint32_t us) {
+    if (us < 4) {
+        return us;
+    }
+    uint8_t msb    = 31 - __builtin_clz(us);
+    uint8_t half   = (us >> (msb - 1)) & 1;
+    uint8_t bucket = 4 + (msb - 2) * 2 + half;
+    return MIN(bucket, TASK_PROFILING_BUCKETS - 1);
+}
+
+static uint32_t bucket_upper_bound(uint8_t bucket) {
+    if (bucket < 4) {
+        return bucket;
+    }
+    uint8_t msb  = (bucket - 4) / 2 + 2;
+    uint8_t half = (bucket - 4) % 2;
+    return ((1UL << msb) | ((uint32_t)half << (msb - 1))) + (1UL << (msb - 1)) - 1;
+}
+
+void task_profiling_record(task_profiling_stage_t stage, uint32_t duration_us) {
+    task_profiling_histogram_t *histogram = &histograms[stage];
+
+    if (histogram->samples == 0 || duration_us < histogram->min_us) {
+        histogram->min_us = duration_us;
+    }
+    if (duration_us > histogram->max_us) {
+        histogram->max_us = duration_us;
+    }
+    if (histogram->samples < UINT32_MAX) {
+        histogram->samples++;
+    }
+
+    uint8_t bucket = bucket_for(duration_us);
+    if (histogram->buckets[bucket] == UINT16_MAX) {
+        // Halve everything rather than saturate, so the distribution keeps its shape
+        for (uint8_t i = 0; i < TASK_PROFILING_BUCKETS; i++) {
+            histogram->buckets[i] >>= 1;
+        }
+    }
+    histogram->buckets[bucket]++;
+}
+
+void task_profiling_get_stats(task_profiling_stage_t stage, task_profiling_stats_t *stats) {
+    const task_profiling_histogram_t *histogram = &histograms[stage];
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < TASK_PROFILING_BUCKETS; i++) {
+        total += histogram->buckets[i];
+    }
+
+    stats->samples = histogram->samples;
+    stats->min_us  = histogram->min_us;
+    stats->max_us  = histogram->max_us;
+    stats->p50_us  = 0;
+    stats->p99_us  = 0;
+    if (total == 0) {
+        return;
+    }
+
+    uint32_t p50_rank = (total + 1) / 2;
+    uint32_t p99_rank = total - total / 100;
+    uint32_t seen     = 0;
+    for (uint8_t i = 0; i < TASK_PROFILING_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (stats->p50_us == 0 && seen >= p50_rank) {
+            stats->p50_us = MIN(bucket_upper_bound(i), histogram->max_us);
+        }
+        if (seen >= p99_rank) {
+            stats->p99_us = MIN(bucket_upper_bound(i), histogram->max_us);
+            break;
+        }
+    }
+}
+
+const char *task_profiling_stage_name(task_profiling_stage_t stage) {
+    if (stage >= TASK_PROFILING_STAGE_COUNT || stage_names[stage] == NULL) {
+        return "";
+    }
+    return stage_names[stage];
+}
+
+void task_profiling_reset(void) {
+    memset(histograms, 0, sizeof(histograms));
+}
+
+void task_profiling_print(void) {
+    for (uint8_t stage = 0; stage < TASK_PROFILING_STAGE_COUNT; stage++) {
+        task_profiling_stats_t stats;
+        task_profiling_get_stats(stage, &stats);
+        dprintf("%s: n=%" PRIu32 " min=%" PRIu32 " p50=%" PRIu32 " p99=%" PRIu32 " max=%" PRIu32 " us\n", task_profiling_stage_name(stage), stats.samples, stats.min_us, stats.p50_us, stats.p99_us, stats.max_us);
+    }
+}
+
+void task_profiling_start(void) {
+    start_timestamp = PROFILE_TIMESTAMP();
+    mark_timestamp  = start_timestamp;
+}
+
+void task_profiling_mark(task_profiling_stage_t stage) {
+    uint32_t now = PROFILE_TIMESTAMP();
+    task_profiling_record(stage, PROFILE_TIMESTAMP_TO_US(now - mark_timestamp));
+    mark_timestamp = now;
+}
+
+void task_profiling_end(void) {
+    task_profiling_record(TASK_PROFILING_KEYBOARD_TASK, PROFILE_ELAPSED_US(start_timestamp));
+
+#if TASK_PROFILING_PRINT_INTERVAL > 0
+    if (debug_enable && timer_elapsed32(print_timer) >= TASK_PROFILING_PRINT_INTERVAL) {
+        print_timer = timer_read32();
+        task_profiling_print();
+    }
+#endif
+}
+
+static void write_u32(uint8_t *data, uint32_t value) {
+    data[0] = value >> 24;
+    data[1] = value >> 16;
+    data[2] = value >> 8;
+    data[3] = value & 0xFF;
+}
+
+void task_profiling_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, channel_id, profiling_command_id, stage, ... ]
+    uint8_t *profiling_command_id = &(data[2]);
+    uint8_t *stage                = &(data[3]);
+
+    switch (*profiling_command_id) {
+        case id_task_profiling_get_stage_count:
+            *stage = TASK_PROFILING_STAGE_COUNT;
+            break;
+        case id_task_profiling_get_stage_stats: {
+            if (*stage >= TASK_PROFILING_STAGE_COUNT || length < 24) {
+                *profiling_command_id = id_task_profiling_unhandled;
+                break;
+            }
+            task_profiling_stats_t stats;
+            task_profiling_get_stats(*stage, &stats);
+            write_u32(&data[4], stats.samples);
+            write_u32(&data[8], stats.min_us);
+            write_u32(&data[12], stats.max_us);
+            write_u32(&data[16], stats.p50_us);
+            write_u32(&data[20], stats.p99_us);
+            break;
+        }
+        case id_task_profiling_get_stage_name:
+            if (*stage >= TASK_PROFILING_STAGE_COUNT) {
+                *profiling_command_id = id_task_profiling_unhandled;
+                break;
+            }
+            strncpy((char *)&data[4], task_profiling_stage_name(*stage), length - 4);
+            data[length - 1] = 0;
+            break;
+        case id_task_profiling_reset:
+            task_profiling_reset();
+            break;
+        default:
+            *profiling_command_id = id_task_profiling_unhandled;
+            break;
+    }
+}
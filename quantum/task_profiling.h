@@ -0,0 +1,129 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+    Per-stage execution time statistics for keyboard_task().
+
+    keyboard_task() takes a timestamp before and after each of the tasks it runs, and
+    the durations are accumulated in a log-scale histogram per stage. Statistics can be
+    printed over the console, or queried over raw HID through raw_hid_receive_quantum().
+*/
+
+#ifdef TASK_PROFILING_ENABLE
+
+#    ifndef TASK_PROFILING_BUCKETS
+#        define TASK_PROFILING_BUCKETS 32
+#    endif
+#    ifndef TASK_PROFILING_PRINT_INTERVAL
+#        define TASK_PROFILING_PRINT_INTERVAL 10000
+#    endif
+
+typedef enum {
+    TASK_PROFILING_MATRIX,
+    TASK_PROFILING_QUANTUM,
+#    ifdef SPLIT_WATCHDOG_ENABLE
+    TASK_PROFILING_SPLIT_WATCHDOG,
+#    endif
+#    ifdef RGBLIGHT_ENABLE
+    TASK_PROFILING_RGBLIGHT,
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    TASK_PROFILING_LED_MATRIX,
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    TASK_PROFILING_RGB_MATRIX,
+#    endif
+#    ifdef BACKLIGHT_ENABLE
+    TASK_PROFILING_BACKLIGHT,
+#    endif
+#    ifdef ENCODER_ENABLE
+    TASK_PROFILING_ENCODER,
+#    endif
+#    ifdef POINTING_DEVICE_ENABLE
+    TASK_PROFILING_POINTING_DEVICE,
+#    endif
+#    ifdef OLED_ENABLE
+    TASK_PROFILING_OLED,
+#    endif
+#    ifdef ST7565_ENABLE
+    TASK_PROFILING_ST7565,
+#    endif
+#    ifdef MOUSEKEY_ENABLE
+    TASK_PROFILING_MOUSEKEY,
+#    endif
+#    ifdef PS2_MOUSE_ENABLE
+    TASK_PROFILING_PS2_MOUSE,
+#    endif
+#    ifdef MIDI_ENABLE
+    TASK_PROFILING_MIDI,
+#    endif
+#    ifdef JOYSTICK_ENABLE
+    TASK_PROFILING_JOYSTICK,
+#    endif
+#    ifdef BATTERY_DRIVER
+    TASK_PROFILING_BATTERY,
+#    endif
+#    ifdef BLUETOOTH_ENABLE
+    TASK_PROFILING_BLUETOOTH,
+#    endif
+#    ifdef HAPTIC_ENABLE
+    TASK_PROFILING_HAPTIC,
+#    endif
+    TASK_PROFILING_LED,
+#    ifdef OS_DETECTION_ENABLE
+    TASK_PROFILING_OS_DETECTION,
+#    endif
+    TASK_PROFILING_KEYBOARD_TASK, // the whole of keyboard_task()
+    TASK_PROFILING_STAGE_COUNT,
+} task_profiling_stage_t;
+
+typedef struct {
+    uint32_t samples;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t p50_us;
+    uint32_t p99_us;
+} task_profiling_stats_t;
+
+enum task_profiling_command_id {
+    id_task_profiling_get_stage_count = 0x01,
+    id_task_profiling_get_stage_stats = 0x02,
+    id_task_profiling_get_stage_name  = 0x03,
+    id_task_profiling_reset           = 0x04,
+    id_task_profiling_unhandled       = 0xFF,
+};
+
+void task_profiling_start(void);
+void task_profiling_mark(task_profiling_stage_t stage);
+void task_profiling_end(void);
+
+/**
+ * \brief Add a single duration to the histogram of a stage.
+ */
+void task_profiling_record(task_profiling_stage_t stage, uint32_t duration_us);
+
+/**
+ * \brief Summarise the histogram of a stage. Percentiles are upper bounds of the matching bucket.
+ */
+void task_profiling_get_stats(task_profiling_stage_t stage, task_profiling_stats_t *stats);
+
+const char *task_profiling_stage_name(task_profiling_stage_t stage);
+
+void task_profiling_reset(void);
+void task_profiling_print(void);
+
+void task_profiling_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#    define TASK_PROFILING_START() task_profiling_start()
+#    define TASK_PROFILING_MARK(stage) task_profiling_mark(TASK_PROFILING_##stage)
+#    define TASK_PROFILING_END() task_profiling_end()
+#else
+#    define TASK_PROFILING_START()
+#    define TASK_PROFILING_MARK(stage)
+#    define TASK_PROFILING_END()
+#endif // TASK_PROFILING_ENABLE
@@ -0,0 +1,100 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "color.h"
+#include "led_tables.h"
+}
+
+namespace {
+
+/* The sector switch that hsv_to_rgb() used to be, kept as the reference */
+rgb_t reference_hsv_to_rgb(hsv_t hsv, bool use_cie) {
+    rgb_t    rgb;
+    uint8_t  region, remainder, p, q, t;
+    uint16_t h, s, v;
+
+    v = use_cie ? CIE1931_CURVE[hsv.v] : hsv.v;
+
+    if (hsv.s == 0) {
+        rgb.r = rgb.g = rgb.b = v;
+        return rgb;
+    }
+
+    h = hsv.h;
+    s = hsv.s;
+
+    region    = h * 6 / 255;
+    remainder = (h * 2 - region * 85) * 3;
+
+    p = (v * (255 - s)) >> 8;
+    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+    switch (region) {
+        case 6:
+        case 0:
+            rgb = {(uint8_t)v, t, p};
+            break;
+        case 1:
+            rgb = {q, (uint8_t)v, p};
+            break;
+        case 2:
+            rgb = {p, (uint8_t)v, t};
+            break;
+        case 3:
+            rgb = {p, q, (uint8_t)v};
+            break;
+        case 4:
+            rgb = {t, p, (uint8_t)v};
+            break;
+        default:
+            rgb = {(uint8_t)v, p, q};
+            break;
+    }
+
+    return rgb;
+}
+
+bool operator==(const rgb_t &a, const rgb_t &b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+} // namespace
+
+class Color : public TestFixture {};
+
+TEST_F(Color, hsv_to_rgb_matches_reference) {
+    for (uint32_t i = 0; i < (1 << 24); i++) {
+        hsv_t hsv = {(uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i};
+        ASSERT_TRUE(hsv_to_rgb(hsv) == reference_hsv_to_rgb(hsv, true)) << "h " << +hsv.h << " s " << +hsv.s << " v " << +hsv.v;
+        ASSERT_TRUE(hsv_to_rgb_nocie(hsv) == reference_hsv_to_rgb(hsv, false)) << "h " << +hsv.h << " s " << +hsv.s << " v " << +hsv.v;
+    }
+}
+
+TEST_F(Color, hsv_to_rgb_batch_matches_hsv_to_rgb) {
+    hsv_t hsv[128];
+    rgb_t rgb[128];
+
+    // Count is a uint8_t, so convert all 2^24 inputs 128 at a time
+    for (uint32_t i = 0; i < (1 << 24); i += 128) {
+        for (uint8_t j = 0; j < 128; j++) {
+            hsv[j] = {(uint8_t)((i + j) >> 16), (uint8_t)((i + j) >> 8), (uint8_t)(i + j)};
+        }
+        hsv_to_rgb_batch(hsv, rgb, 128);
+        for (uint8_t j = 0; j < 128; j++) {
+            ASSERT_TRUE(rgb[j] == hsv_to_rgb(hsv[j])) << "h " << +hsv[j].h << " s " << +hsv[j].s << " v " << +hsv[j].v;
+        }
+    }
+}
+
+TEST_F(Color, hsv_to_rgb_batch_empty) {
+    rgb_t rgb = {1, 2, 3};
+    hsv_to_rgb_batch(NULL, &rgb, 0);
+    EXPECT_EQ(rgb.r, 1);
+    EXPECT_EQ(rgb.g, 2);
+    EXPECT_EQ(rgb.b, 3);
+}
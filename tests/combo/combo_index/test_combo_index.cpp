@@ -0,0 +1,125 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_common.hpp"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "test_combos_index.h"
+
+/* Lets tests shrink the combo list without touching key_combos */
+static uint16_t test_combo_count = TEST_COMBO_COUNT;
+
+uint16_t combo_count(void) {
+    return test_combo_count;
+}
+}
+
+using testing::_;
+
+class ComboIndex : public TestFixture {
+   protected:
+    void SetUp() override {
+        test_combos_init();
+        test_combo_count = TEST_COMBO_COUNT;
+        combo_index_invalidate();
+    }
+
+    /* Average time of process_combo() for a press and release of a key outside all combos */
+    std::chrono::nanoseconds time_unrelated_key(uint16_t count) {
+        test_combo_count = count;
+        combo_index_invalidate();
+
+        keyrecord_t record   = {};
+        record.event.type    = KEY_EVENT;
+        record.event.pressed = true;
+        process_combo(KC_F24, &record);
+
+        const int iterations = 20000;
+        auto      best       = std::chrono::nanoseconds::max();
+        for (int run = 0; run < 5; run++) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; i++) {
+                record.event.pressed = !record.event.pressed;
+                process_combo(KC_F24, &record);
+            }
+            best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start) / iterations);
+        }
+        return best;
+    }
+};
+
+TEST_F(ComboIndex, first_combo_fires) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 0, 1, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (TEST_COMBO_RESULT(0)));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, last_combo_fires) {
+    TestDriver driver;
+    KeymapKey  key_t(0, 0, 0, KC_T);
+    KeymapKey  key_z(0, 0, 1, KC_Z);
+    set_keymap({key_t, key_z});
+
+    EXPECT_REPORT(driver, (TEST_COMBO_RESULT(TEST_COMBO_COUNT - 1)));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_z, key_t});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, keys_outside_combos_pass_through) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_f24(0, 0, 1, KC_F24);
+    set_keymap({key_a, key_f24});
+
+    EXPECT_REPORT(driver, (KC_F24));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_f24);
+    VERIFY_AND_CLEAR(driver);
+
+    // A key that only starts combos is released as itself
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, combos_removed_at_runtime_are_ignored) {
+    TestDriver driver;
+    KeymapKey  key_t(0, 0, 0, KC_T);
+    KeymapKey  key_z(0, 0, 1, KC_Z);
+    set_keymap({key_t, key_z});
+
+    test_combo_count = TEST_COMBO_COUNT - 1;
+    combo_index_invalidate();
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_REPORT(driver, (KC_Z, KC_T));
+    EXPECT_REPORT(driver, (KC_T));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_z, key_t});
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Timing depends on the host, run with --gtest_also_run_disabled_tests
+TEST_F(ComboIndex, DISABLED_benchmark_time_does_not_grow_with_combo_count) {
+    auto small = time_unrelated_key(TEST_COMBO_COUNT / 10);
+    auto large = time_unrelated_key(TEST_COMBO_COUNT);
+
+    // A linear scan would be roughly ten times slower with ten times the combos
+    EXPECT_LT(large.count(), small.count() * 3 + 50) << "50 combos: " << small.count() << "ns, 500 combos: " << large.count() << "ns";
+}
@@ -0,0 +1,25 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "test_combos_index.h"
+
+/* Every pair of the keys below is a combo, up to TEST_COMBO_COUNT of them. The
+ * definitions are generated at runtime to keep this file short. */
+static const uint16_t test_combo_pool[] = {KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M, KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z, KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0};
+
+static uint16_t test_combo_keys[TEST_COMBO_COUNT][3];
+
+combo_t key_combos[TEST_COMBO_COUNT];
+
+void test_combos_init(void) {
+    uint16_t idx = 0;
+    for (uint8_t first = 0; first < ARRAY_SIZE(test_combo_pool) && idx < TEST_COMBO_COUNT; first++) {
+        for (uint8_t second = first + 1; second < ARRAY_SIZE(test_combo_pool) && idx < TEST_COMBO_COUNT; second++, idx++) {
+            test_combo_keys[idx][0] = test_combo_pool[first];
+            test_combo_keys[idx][1] = test_combo_pool[second];
+            test_combo_keys[idx][2] = COMBO_END;
+            key_combos[idx]         = (combo_t)COMBO(test_combo_keys[idx], TEST_COMBO_RESULT(idx));
+        }
+    }
+}
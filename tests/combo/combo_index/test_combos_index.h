@@ -0,0 +1,11 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+#define TEST_COMBO_COUNT 500
+#define TEST_COMBO_RESULT(idx) (KC_F1 + (idx) % 12)
+
+void test_combos_init(void);
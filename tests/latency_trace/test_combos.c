@@ -0,0 +1,8 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+uint16_t const space_combo[] = {KC_Y, KC_U, COMBO_END};
+
+combo_t key_combos[] = {COMBO(space_combo, KC_SPACE)};
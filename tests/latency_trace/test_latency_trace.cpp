@@ -0,0 +1,247 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "latency_trace.h"
+#include "raw_hid.h"
+}
+
+using testing::_;
+
+class LatencyTrace : public TestFixture {
+   protected:
+    void SetUp() override {
+        latency_trace_clear();
+    }
+
+    latency_trace_entry_t pop() {
+        latency_trace_entry_t entry = {};
+        EXPECT_TRUE(latency_trace_pop(&entry));
+        return entry;
+    }
+};
+
+TEST_F(LatencyTrace, PlainKeyIsTracedOnBothEdges) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 1, 2, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(latency_trace_count(), 2);
+    auto press = pop();
+    EXPECT_EQ(press.key.row, 2);
+    EXPECT_EQ(press.key.col, 1);
+    EXPECT_EQ(press.type, KEY_EVENT);
+    EXPECT_TRUE(press.pressed);
+    EXPECT_EQ(press.latency_us, 0);
+    auto release = pop();
+    EXPECT_FALSE(release.pressed);
+    EXPECT_EQ(release.latency_us, 0);
+}
+
+TEST_F(LatencyTrace, TappingTermWaitIsIncluded) {
+    TestDriver driver;
+    KeymapKey  key_mod_tap(0, 0, 0, LSFT_T(KC_P));
+    set_keymap({key_mod_tap});
+
+    EXPECT_NO_REPORT(driver);
+    key_mod_tap.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM / 2);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(latency_trace_count(), 0);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    key_mod_tap.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(latency_trace_count(), 2);
+    auto press = pop();
+    EXPECT_TRUE(press.pressed);
+    EXPECT_EQ(press.latency_us, (TAPPING_TERM / 2 + 1) * 1000);
+    EXPECT_EQ(pop().latency_us, 0);
+}
+
+TEST_F(LatencyTrace, ComboBufferWaitIsIncluded) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 0, KC_Y);
+    KeymapKey  key_u(0, 0, 1, KC_U);
+    set_keymap({key_y, key_u});
+
+    // The combo timer treats a timestamp of 0 as stopped
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_Y));
+    key_y.press();
+    idle_for(COMBO_TERM + 2);
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(latency_trace_count(), 1);
+    auto press = pop();
+    EXPECT_TRUE(press.pressed);
+    EXPECT_EQ(press.latency_us, (COMBO_TERM + 1) * 1000);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_y.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, CombosAreTracedFromTheirLastKey) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 0, KC_Y);
+    KeymapKey  key_u(0, 0, 1, KC_U);
+    set_keymap({key_y, key_u});
+
+    // The combo timer treats a timestamp of 0 as stopped
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_SPACE));
+    key_y.press();
+    run_one_scan_loop();
+    key_u.press();
+    idle_for(COMBO_TERM + 2);
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(latency_trace_count(), 1);
+    auto press = pop();
+    EXPECT_EQ(press.type, COMBO_EVENT);
+    EXPECT_TRUE(press.pressed);
+    // The combo fires once more than COMBO_TERM has passed since its last key
+    EXPECT_EQ(press.latency_us, (COMBO_TERM + 1) * 1000);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_y.release();
+    key_u.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, EventsWithoutReportsAreNotRecorded) {
+    TestDriver driver;
+    KeymapKey  key_layer(0, 0, 0, MO(1));
+    KeymapKey  key_b(1, 1, 0, KC_B);
+    set_keymap({key_layer, key_b, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(0, 1, 0, KC_NO)});
+
+    EXPECT_NO_REPORT(driver);
+    key_layer.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(latency_trace_count(), 0);
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    ASSERT_EQ(latency_trace_count(), 1);
+    EXPECT_EQ(pop().key.col, 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    key_layer.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, RingBufferKeepsNewestEntries) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 1, 2, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A)).Times(LATENCY_TRACE_BUFFER_SIZE);
+    EXPECT_EMPTY_REPORT(driver).Times(LATENCY_TRACE_BUFFER_SIZE);
+    for (int i = 0; i < LATENCY_TRACE_BUFFER_SIZE; i++) {
+        tap_key(key_a);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(latency_trace_count(), LATENCY_TRACE_BUFFER_SIZE);
+    EXPECT_EQ(latency_trace_total(), LATENCY_TRACE_BUFFER_SIZE * 2);
+    // The oldest half has been overwritten, so the buffer starts with a press again
+    EXPECT_TRUE(pop().pressed);
+}
+
+TEST_F(LatencyTrace, RawHidRead) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 1, 2, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A)).Times(3);
+    EXPECT_EMPTY_REPORT(driver).Times(3);
+    for (int i = 0; i < 3; i++) {
+        tap_key(key_a);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    uint8_t data[32] = {RAW_HID_QUANTUM_COMMAND_ID, id_latency_trace_channel, id_latency_trace_get_count};
+    latency_trace_raw_hid_receive(data, sizeof(data));
+    EXPECT_EQ(data[3], 6);
+    EXPECT_EQ(data[7], 6);
+
+    // 4 entries of 7 bytes fit in a 32 byte report
+    data[2] = id_latency_trace_read;
+    latency_trace_raw_hid_receive(data, sizeof(data));
+    EXPECT_EQ(data[3], 4);
+    EXPECT_EQ(data[4], 2);
+    EXPECT_EQ(data[5], 1);
+    EXPECT_EQ(data[6], 1 | (KEY_EVENT << 1));
+    EXPECT_EQ(data[13], 0 | (KEY_EVENT << 1));
+
+    data[2] = id_latency_trace_read;
+    latency_trace_raw_hid_receive(data, sizeof(data));
+    EXPECT_EQ(data[3], 2);
+    EXPECT_EQ(latency_trace_count(), 0);
+
+    data[2] = 0x42;
+    latency_trace_raw_hid_receive(data, sizeof(data));
+    EXPECT_EQ(data[2], id_latency_trace_unhandled);
+}
+
+TEST_F(LatencyTrace, RawEdgesSurviveDebounce) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    matrix_row_t previous[MATRIX_ROWS]  = {0};
+    matrix_row_t current[MATRIX_ROWS]   = {0};
+    matrix_row_t debounced[MATRIX_ROWS] = {0};
+
+    // Raw press seen 5ms before debounce lets it through
+    current[1] = 0b100;
+    latency_trace_matrix_scan(previous, current, debounced, 0, MATRIX_ROWS);
+    idle_for(5);
+    EXPECT_EQ(latency_trace_key_event(1, 2) - 1, timer_read32() - 5);
+
+    // Tags are consumed, later events without an edge fall back to the current time
+    EXPECT_EQ(latency_trace_key_event(1, 2) - 1, timer_read32());
+}
+
+TEST_F(LatencyTrace, BounceBackCancelsRawEdge) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    matrix_row_t previous[MATRIX_ROWS]  = {0};
+    matrix_row_t current[MATRIX_ROWS]   = {0};
+    matrix_row_t debounced[MATRIX_ROWS] = {0};
+
+    current[0] = 0b1;
+    latency_trace_matrix_scan(previous, current, debounced, 0, MATRIX_ROWS);
+    idle_for(2);
+    latency_trace_matrix_scan(current, previous, debounced, 0, MATRIX_ROWS);
+    idle_for(3);
+
+    // The edge that debounce eventually reports starts here
+    uint32_t edge = timer_read32();
+    latency_trace_matrix_scan(previous, current, debounced, 0, MATRIX_ROWS);
+    idle_for(5);
+    EXPECT_EQ(latency_trace_key_event(0, 0) - 1, edge);
+}
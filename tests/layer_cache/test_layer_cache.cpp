@@ -0,0 +1,181 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "layer_cache.h"
+}
+
+using testing::_;
+
+#define TEST_LAYER_COUNT 4
+
+class LayerCache : public TestFixture {
+   protected:
+    /* Position n is transparent on layer l when bit l of n is set, so the first
+     * 16 positions cover every transparency pattern across the test layers. */
+    static bool is_transparent(uint8_t layer, uint8_t row, uint8_t col) {
+        return ((row * MATRIX_COLS + col) >> layer) & 1;
+    }
+
+    /* Replaces the keymap without touching the cache, optionally mapping position 15 on layer 2 */
+    void fill_keymap(bool remap = false) {
+        keymap.clear();
+        for (uint8_t layer = 0; layer < TEST_LAYER_COUNT; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    uint16_t keycode = is_transparent(layer, row, col) ? KC_TRANSPARENT : KC_A + layer;
+                    if (remap && layer == 2 && row == 1 && col == 5) {
+                        keycode = KC_Z;
+                    }
+                    add_key(KeymapKey(layer, col, row, keycode));
+                }
+            }
+        }
+    }
+
+    /* Reference implementation, mirrors the uncached walk in layer_switch_get_layer */
+    static uint8_t walk_layers(layer_state_t layers, uint8_t row, uint8_t col) {
+        for (int8_t i = TEST_LAYER_COUNT - 1; i >= 0; i--) {
+            if ((layers & ((layer_state_t)1 << i)) && !is_transparent(i, row, col)) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    void expect_matches_walk(void) {
+        layer_state_t layers = layer_state | default_layer_state;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = {.col = col, .row = row};
+                EXPECT_EQ(layer_switch_get_layer(key), walk_layers(layers, row, col)) << "layer_state " << +layer_state << " default_layer_state " << +default_layer_state << " (col,row) (" << +col << "," << +row << ")";
+            }
+        }
+    }
+
+    void TearDown() override {
+        default_layer_set(1);
+    }
+};
+
+TEST_F(LayerCache, MatchesWalkForEveryLayerCombination) {
+    fill_keymap();
+    layer_cache_invalidate();
+
+    for (layer_state_t default_layers = 0; default_layers < (1 << TEST_LAYER_COUNT); default_layers++) {
+        default_layer_set(default_layers);
+        for (layer_state_t layers = 0; layers < (1 << TEST_LAYER_COUNT); layers++) {
+            layer_state_set(layers);
+            expect_matches_walk();
+        }
+    }
+}
+
+TEST_F(LayerCache, MatchesWalkForEveryLayerTransition) {
+    fill_keymap();
+    layer_cache_invalidate();
+    default_layer_set(0);
+
+    for (layer_state_t from = 0; from < (1 << TEST_LAYER_COUNT); from++) {
+        for (layer_state_t to = 0; to < (1 << TEST_LAYER_COUNT); to++) {
+            layer_state_set(from);
+            expect_matches_walk();
+            layer_state_set(to);
+            expect_matches_walk();
+        }
+    }
+}
+
+TEST_F(LayerCache, MatchesWalkForSingleLayerChanges) {
+    fill_keymap();
+    layer_cache_invalidate();
+    default_layer_set(1);
+
+    /* Deterministic pseudo random sequence of layer toggles */
+    uint32_t seed = 0x1234;
+    for (int i = 0; i < 500; i++) {
+        seed = seed * 1103515245 + 12345;
+        switch ((seed >> 16) % 3) {
+            case 0:
+                layer_on((seed >> 20) % TEST_LAYER_COUNT);
+                break;
+            case 1:
+                layer_off((seed >> 20) % TEST_LAYER_COUNT);
+                break;
+            case 2:
+                layer_invert((seed >> 20) % TEST_LAYER_COUNT);
+                break;
+        }
+        expect_matches_walk();
+    }
+}
+
+TEST_F(LayerCache, FollowsDirectLayerStateWrites) {
+    fill_keymap();
+    layer_cache_invalidate();
+    default_layer_set(1);
+    layer_state_set(0);
+    expect_matches_walk();
+
+    /* Split slaves overwrite the layer state without going through layer_state_set */
+    layer_state = 0b1010;
+    expect_matches_walk();
+    default_layer_state = 0b0100;
+    expect_matches_walk();
+}
+
+TEST_F(LayerCache, FollowsKeymapChanges) {
+    fill_keymap();
+    layer_cache_invalidate();
+    default_layer_set(1);
+    layer_state_set(0b1110);
+    expect_matches_walk();
+
+    /* Position 15 is transparent on every layer, map it on layer 2 */
+    keypos_t key = {.col = 5, .row = 1};
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+    fill_keymap(true);
+    layer_cache_invalidate_key(key);
+    EXPECT_EQ(layer_switch_get_layer(key), 2);
+
+    fill_keymap();
+    layer_cache_invalidate_key(key);
+    expect_matches_walk();
+}
+
+TEST_F(LayerCache, KeyPressUsesResolvedLayer) {
+    TestDriver driver;
+    KeymapKey  layer_key   = KeymapKey(0, 0, 0, MO(1));
+    KeymapKey  regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({layer_key, regular_key, KeymapKey(1, 0, 0, KC_TRANSPARENT), KeymapKey(1, 1, 0, KC_B)});
+    /* The cache resolves every position, so map the remaining ones as well */
+    for (uint8_t layer = 0; layer < 2; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (row != 0 || col > 1) {
+                    add_key(KeymapKey(layer, col, row, KC_NO));
+                }
+            }
+        }
+    }
+    layer_cache_invalidate();
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    tap_key(regular_key);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+}
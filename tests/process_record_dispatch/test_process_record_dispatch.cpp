@@ -0,0 +1,134 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "process_record_dispatch.h"
+}
+
+using testing::_;
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+namespace {
+std::vector<int> calls;
+
+template <int id, bool result>
+bool handler(uint16_t keycode, keyrecord_t *record) {
+    calls.push_back(id);
+    return result;
+}
+
+bool count_only(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+} // namespace
+
+class ProcessRecordDispatch : public TestFixture {
+   protected:
+    keyrecord_t record = {};
+
+    void SetUp() override {
+        calls.clear();
+    }
+
+    template <size_t count>
+    bool dispatch(const process_record_route_t (&routes)[count], uint16_t keycode) {
+        return process_record_dispatch(routes, count, keycode, &record);
+    }
+};
+
+TEST_F(ProcessRecordDispatch, routes_by_keycode_range_in_table_order) {
+    const process_record_route_t routes[] = {
+        PROCESS_RECORD_OBSERVE_ALL((handler<1, true>)),
+        PROCESS_RECORD_RANGE((handler<2, true>), QK_LIGHTING, QK_LIGHTING_MAX),
+        PROCESS_RECORD_OBSERVE_ALL((handler<3, true>)),
+        PROCESS_RECORD_RANGE((handler<4, true>), QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE),
+    };
+
+    EXPECT_TRUE(dispatch(routes, KC_A));
+    EXPECT_THAT(calls, ElementsAre(1, 3));
+
+    calls.clear();
+    EXPECT_TRUE(dispatch(routes, QK_LIGHTING_MAX));
+    EXPECT_THAT(calls, ElementsAre(1, 2, 3));
+
+    calls.clear();
+    EXPECT_TRUE(dispatch(routes, QK_GRAVE_ESCAPE));
+    EXPECT_THAT(calls, ElementsAre(1, 3, 4));
+}
+
+TEST_F(ProcessRecordDispatch, stops_at_first_consuming_handler) {
+    const process_record_route_t routes[] = {
+        PROCESS_RECORD_RANGE((handler<1, false>), QK_LIGHTING, QK_LIGHTING_MAX),
+        PROCESS_RECORD_OBSERVE_ALL((handler<2, false>)),
+        PROCESS_RECORD_OBSERVE_ALL((handler<3, true>)),
+    };
+
+    EXPECT_FALSE(dispatch(routes, QK_LIGHTING));
+    EXPECT_THAT(calls, ElementsAre(1));
+
+    calls.clear();
+    EXPECT_FALSE(dispatch(routes, KC_A));
+    EXPECT_THAT(calls, ElementsAre(2));
+}
+
+TEST_F(ProcessRecordDispatch, keycodes_outside_range_skip_handler) {
+    const process_record_route_t routes[] = {
+        PROCESS_RECORD_RANGE((handler<1, false>), QK_MAGIC, QK_MAGIC_MAX),
+    };
+
+    EXPECT_TRUE(dispatch(routes, QK_MAGIC - 1));
+    EXPECT_TRUE(dispatch(routes, QK_MAGIC_MAX + 1));
+    EXPECT_THAT(calls, IsEmpty());
+}
+
+TEST_F(ProcessRecordDispatch, keys_are_still_processed) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ProcessRecordDispatch, benchmark_basic_keycode) {
+    // Shaped like a feature rich keymap: a few handlers that observe every key,
+    // and many that only act on their own keycode range.
+    std::vector<process_record_route_t> routed;
+    std::vector<process_record_route_t> chained;
+    for (int i = 0; i < 24; i++) {
+        bool observe_all = i % 4 == 0;
+        routed.push_back(observe_all ? process_record_route_t PROCESS_RECORD_OBSERVE_ALL(count_only) : process_record_route_t PROCESS_RECORD_RANGE(count_only, QK_LIGHTING, QK_LIGHTING_MAX));
+        chained.push_back(process_record_route_t PROCESS_RECORD_OBSERVE_ALL(count_only));
+    }
+
+    const uint32_t iterations = 1000000;
+    auto           time       = [&](const std::vector<process_record_route_t> &routes) {
+        bool passed = true;
+        auto start  = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            passed &= process_record_dispatch(routes.data(), routes.size(), KC_A + (i & 0x1F), &record);
+        }
+        EXPECT_TRUE(passed);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto chained_ns = time(chained);
+    auto routed_ns  = time(routed);
+
+    // Host timings, compare runs of the same build only.
+    RecordProperty("chained_ns_per_event", chained_ns / iterations);
+    RecordProperty("routed_ns_per_event", routed_ns / iterations);
+    std::cout << "dispatch of a basic keycode: " << chained_ns / iterations << "ns calling every handler, " << routed_ns / iterations << "ns routed" << std::endl;
+}
@@ -0,0 +1,71 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// Filled in by benchmark_layout_init() so the layout follows RGB_MATRIX_LED_COUNT
+led_config_t g_led_config;
+
+rgb_t    benchmark_leds[RGB_MATRIX_LED_COUNT];
+uint32_t benchmark_flushes    = 0;
+uint32_t benchmark_frame_hash = 2166136261u; // FNV-1a over every frame flushed, to compare renders between builds
+
+static void benchmark_init(void) {}
+
+static void benchmark_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    benchmark_leds[index].r = r;
+    benchmark_leds[index].g = g;
+    benchmark_leds[index].b = b;
+}
+
+static void benchmark_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        benchmark_set_color(i, r, g, b);
+    }
+}
+
+static void benchmark_flush(void) {
+    const uint8_t *bytes = (const uint8_t *)benchmark_leds;
+    for (size_t i = 0; i < sizeof(benchmark_leds); i++) {
+        benchmark_frame_hash = (benchmark_frame_hash ^ bytes[i]) * 16777619u;
+    }
+    benchmark_flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = benchmark_init,
+    .set_color     = benchmark_set_color,
+    .set_color_all = benchmark_set_color_all,
+    .flush         = benchmark_flush,
+};
+
+/* Keys on a regular grid with the outer columns as modifiers, any remaining
+ * LEDs spread along the top and bottom edges as underglow. */
+void benchmark_layout_init(void) {
+    uint8_t led = 0;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (led >= RGB_MATRIX_LED_COUNT) {
+                g_led_config.matrix_co[row][col] = NO_LED;
+                continue;
+            }
+            g_led_config.matrix_co[row][col] = led;
+            g_led_config.point[led].x        = col * 224 / (MATRIX_COLS - 1);
+            g_led_config.point[led].y        = row * 64 / (MATRIX_ROWS - 1);
+            g_led_config.flags[led]          = (col == 0 || col == MATRIX_COLS - 1) ? LED_FLAG_MODIFIER : LED_FLAG_KEYLIGHT;
+            led++;
+        }
+    }
+
+    uint8_t underglow = RGB_MATRIX_LED_COUNT - led;
+    for (uint8_t i = 0; led < RGB_MATRIX_LED_COUNT; i++, led++) {
+        g_led_config.point[led].x = (i / 2) * 224 / ((underglow + 1) / 2);
+        g_led_config.point[led].y = (i % 2) ? 64 : 0;
+        g_led_config.flags[led]   = LED_FLAG_UNDERGLOW;
+    }
+
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    rgb_matrix_update_geometry();
+#endif
+}
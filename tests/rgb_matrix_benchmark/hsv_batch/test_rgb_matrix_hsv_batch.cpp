@@ -0,0 +1,10 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../rgb_matrix_benchmark.hpp"
+
+class RgbMatrixHsvBatch : public RgbMatrixBenchmark {};
+
+TEST_F(RgbMatrixHsvBatch, frames_match_per_pixel_path) {
+    expect_reference_frames();
+}
@@ -0,0 +1,117 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+extern uint32_t benchmark_flushes;
+extern uint32_t benchmark_frame_hash;
+void            benchmark_layout_init(void);
+void            advance_time(uint32_t ms);
+}
+
+namespace {
+
+const char *const effect_names[] = {
+    "NONE",
+#define RGB_MATRIX_EFFECT(name, ...) #name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+
+/* Regression thresholds in ns/LED/frame, generous enough for unoptimised
+ * and sanitized host builds, catching effects that become an order of
+ * magnitude slower. Effects not listed use the default. */
+const uint32_t default_threshold = 2000;
+
+struct effect_threshold {
+    uint8_t  mode;
+    uint32_t ns_per_led_frame;
+};
+
+const effect_threshold effect_thresholds[] = {
+    {RGB_MATRIX_SOLID_COLOR, 500},
+    {RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE, 10000},
+    {RGB_MATRIX_SOLID_REACTIVE_MULTICROSS, 10000},
+    {RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS, 10000},
+    {RGB_MATRIX_MULTISPLASH, 10000},
+    {RGB_MATRIX_SOLID_MULTISPLASH, 10000},
+};
+
+uint32_t threshold(uint8_t mode) {
+    for (const auto &t : effect_thresholds) {
+        if (t.mode == mode) {
+            return t.ns_per_led_frame;
+        }
+    }
+    return default_threshold;
+}
+
+/* Hash of the first frames of every effect rendered through the per-pixel HSV to RGB path, which
+ * the RGB_MATRIX_HSV_BATCH variant must reproduce. Update it when an effect's output changes. */
+const uint32_t reference_frame_hash = 2648416180u;
+const uint32_t reference_frames     = 8;
+
+} // namespace
+
+class RgbMatrixBenchmark : public TestFixture {
+   protected:
+    void SetUp() override {
+        benchmark_layout_init();
+    }
+
+    /* Deterministic xorshift, so every run presses the same keys */
+    uint32_t next_random() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    /* Renders `frames` frames of the current effect, tapping a random key every
+     * few frames to drive the reactive effects, and returns ns/LED/frame. */
+    double render(uint32_t frames) {
+        uint32_t first = benchmark_flushes;
+        uint32_t hit   = first;
+
+        auto start = std::chrono::steady_clock::now();
+        while (benchmark_flushes - first < frames) {
+            if (benchmark_flushes - hit >= 4) {
+                uint8_t row = next_random() % MATRIX_ROWS;
+                uint8_t col = next_random() % MATRIX_COLS;
+                rgb_matrix_handle_key_event(row, col, true);
+                rgb_matrix_handle_key_event(row, col, false);
+                hit = benchmark_flushes;
+            }
+            rgb_matrix_task();
+            advance_time(1);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        return (double)elapsed.count() / frames / RGB_MATRIX_LED_COUNT;
+    }
+
+    /* Renders the reference frames of every effect, from a fresh start so that every build
+     * renders the same, and checks them against the reference hash. */
+    void expect_reference_frames() {
+        rgb_matrix_enable_noeeprom();
+
+        uint32_t first = benchmark_flushes;
+        for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+            rgb_matrix_mode_noeeprom(mode);
+            render(reference_frames);
+        }
+        EXPECT_EQ(benchmark_flushes - first, reference_frames * (RGB_MATRIX_EFFECT_MAX - RGB_MATRIX_NONE - 1));
+        EXPECT_EQ(benchmark_frame_hash, reference_frame_hash);
+    }
+
+    uint32_t seed = 0x12345678;
+};
+
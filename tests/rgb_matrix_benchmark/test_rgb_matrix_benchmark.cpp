@@ -0,0 +1,46 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix_benchmark.hpp"
+
+/* Runs first, so that the renderer starts from the same state as in the hsv_batch variant */
+TEST_F(RgbMatrixBenchmark, frames_match_reference) {
+    expect_reference_frames();
+}
+
+TEST_F(RgbMatrixBenchmark, every_effect_renders) {
+    static_assert(sizeof(effect_names) / sizeof(effect_names[0]) == RGB_MATRIX_EFFECT_MAX, "effect name table out of sync");
+
+    rgb_matrix_enable_noeeprom();
+
+    for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        rgb_matrix_mode_noeeprom(mode);
+        ASSERT_EQ(rgb_matrix_get_mode(), mode);
+
+        uint32_t first = benchmark_flushes;
+        render(4);
+        EXPECT_EQ(benchmark_flushes - first, 4) << effect_names[mode];
+    }
+}
+
+/* Timings depend on the host and the build, so this only runs on request:
+ *
+ *   .build/test/rgb_matrix_benchmark.elf --gtest_also_run_disabled_tests
+ */
+TEST_F(RgbMatrixBenchmark, DISABLED_every_effect_within_threshold) {
+    rgb_matrix_enable_noeeprom();
+    RecordProperty("leds", RGB_MATRIX_LED_COUNT);
+    RecordProperty("frames", RGB_MATRIX_BENCHMARK_FRAMES);
+
+    for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        rgb_matrix_mode_noeeprom(mode);
+        ASSERT_EQ(rgb_matrix_get_mode(), mode);
+
+        double ns = render(RGB_MATRIX_BENCHMARK_FRAMES);
+
+        // Timings vary between hosts and builds, compare runs of the same build only.
+        RecordProperty(effect_names[mode], std::to_string(ns));
+        std::cout << std::left << std::setw(28) << effect_names[mode] << std::right << std::fixed << std::setprecision(1) << std::setw(10) << ns << "ns per LED per frame" << std::endl;
+        EXPECT_LE(ns, threshold(mode)) << effect_names[mode];
+    }
+}
@@ -0,0 +1,43 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+led_config_t g_led_config;
+
+rgb_t    direct_leds[RGB_MATRIX_LED_COUNT];
+rgb_t    direct_shown[RGB_MATRIX_LED_COUNT];
+uint32_t direct_flushes = 0;
+bool     direct_busy    = false;
+
+static void direct_init(void) {}
+
+static void direct_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    direct_leds[index].r = r;
+    direct_leds[index].g = g;
+    direct_leds[index].b = b;
+}
+
+static void direct_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        direct_set_color(i, r, g, b);
+    }
+}
+
+static void direct_flush(void) {
+    memcpy(direct_shown, direct_leds, sizeof(direct_shown));
+    direct_flushes++;
+}
+
+// Stands in for a driver still sending the previous frame in the background
+static bool direct_flush_pending(void) {
+    return direct_busy;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = direct_init,
+    .set_color     = direct_set_color,
+    .set_color_all = direct_set_color_all,
+    .flush         = direct_flush,
+    .flush_pending = direct_flush_pending,
+};
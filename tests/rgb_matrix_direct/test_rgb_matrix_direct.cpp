@@ -0,0 +1,249 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "raw_hid.h"
+#include "rgb_matrix_direct.h"
+
+extern rgb_t    direct_leds[];
+extern rgb_t    direct_shown[];
+extern uint32_t direct_flushes;
+extern bool     direct_busy;
+void            advance_time(uint32_t ms);
+}
+
+class RgbMatrixDirect : public TestFixture {
+   protected:
+    void SetUp() override {
+        direct_busy = false;
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(0, 0, UINT8_MAX);
+        // Every test starts from black, with the direct effect freshly selected
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_NONE);
+        run(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+        send(id_rgb_matrix_direct_begin);
+        run(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    }
+
+    void run(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            rgb_matrix_task();
+            advance_time(1);
+        }
+    }
+
+    /* Sends a report on the direct channel, returning whether it was handled */
+    bool send(uint8_t command, const std::vector<uint8_t> &payload = {}) {
+        memset(report, 0, sizeof(report));
+        report[0]   = RAW_HID_QUANTUM_COMMAND_ID;
+        report[1]   = id_rgb_matrix_direct_channel;
+        report[2]   = command;
+        uint8_t pos = 3;
+        for (uint8_t byte : payload) {
+            report[pos++] = byte;
+        }
+        return raw_hid_receive_quantum(report, sizeof(report));
+    }
+
+    bool frame(uint8_t seq, uint8_t flags, std::initializer_list<uint8_t> runs) {
+        std::vector<uint8_t> payload = {seq, flags};
+        payload.insert(payload.end(), runs);
+        return send(id_rgb_matrix_direct_frame, payload);
+    }
+
+    void expect_led(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
+        EXPECT_EQ(direct_leds[index].r, r) << "LED " << (int)index;
+        EXPECT_EQ(direct_leds[index].g, g) << "LED " << (int)index;
+        EXPECT_EQ(direct_leds[index].b, b) << "LED " << (int)index;
+    }
+
+    void expect_shown(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
+        EXPECT_EQ(direct_shown[index].r, r) << "LED " << (int)index;
+        EXPECT_EQ(direct_shown[index].g, g) << "LED " << (int)index;
+        EXPECT_EQ(direct_shown[index].b, b) << "LED " << (int)index;
+    }
+
+    // Acknowledgements are sent through the host driver
+    TestDriver driver;
+    uint8_t    report[32];
+};
+
+static const uint8_t whole = RGB_MATRIX_DIRECT_FRAME_START | RGB_MATRIX_DIRECT_FRAME_END | RGB_MATRIX_DIRECT_FRAME_ACK;
+
+TEST_F(RgbMatrixDirect, BeginSwitchesToDirectAndClears) {
+    frame(1, whole, {0, RGB_MATRIX_LED_COUNT | RGB_MATRIX_DIRECT_RUN_REPEAT, 1, 2, 3});
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    run(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    expect_led(0, 1, 2, 3);
+
+    EXPECT_TRUE(send(id_rgb_matrix_direct_begin));
+    EXPECT_EQ(report[3], rgb_matrix_direct_ok);
+    EXPECT_EQ(rgb_matrix_get_mode(), RGB_MATRIX_DIRECT);
+
+    run(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        expect_led(i, 0, 0, 0);
+    }
+}
+
+TEST_F(RgbMatrixDirect, FrameWritesRuns) {
+    // LEDs 2 to 3 one by one, then 10 to 14 all the same color
+    EXPECT_TRUE(frame(1, whole, {2, 2, 1, 2, 3, 4, 5, 6, 10, 5 | RGB_MATRIX_DIRECT_RUN_REPEAT, 7, 8, 9}));
+    EXPECT_EQ(report[3], rgb_matrix_direct_ok);
+    EXPECT_EQ(report[4], 1);
+
+    expect_led(1, 0, 0, 0);
+    expect_led(2, 1, 2, 3);
+    expect_led(3, 4, 5, 6);
+    expect_led(4, 0, 0, 0);
+    for (uint8_t i = 10; i < 15; i++) {
+        expect_led(i, 7, 8, 9);
+    }
+    expect_led(15, 0, 0, 0);
+    EXPECT_EQ(rgb_matrix_direct_frames(), 1);
+}
+
+TEST_F(RgbMatrixDirect, FrameFollowsBrightness) {
+    rgb_matrix_sethsv_noeeprom(0, 0, 128);
+    frame(1, whole, {0, 1, 200, 100, 0});
+    expect_led(0, 100, 50, 0);
+}
+
+TEST_F(RgbMatrixDirect, FlushWaitsForLastReport) {
+    uint32_t flushes = direct_flushes;
+
+    frame(1, RGB_MATRIX_DIRECT_FRAME_START, {0, 1, 1, 1, 1});
+    run(RGB_MATRIX_DIRECT_TIMEOUT / 2);
+    EXPECT_EQ(direct_flushes, flushes);
+    EXPECT_TRUE(rgb_matrix_direct_receiving());
+
+    frame(1, RGB_MATRIX_DIRECT_FRAME_END, {1, 1, 2, 2, 2});
+    EXPECT_FALSE(rgb_matrix_direct_receiving());
+    run(2);
+    EXPECT_EQ(direct_flushes, flushes + 1);
+    expect_led(0, 1, 1, 1);
+    expect_led(1, 2, 2, 2);
+    EXPECT_EQ(rgb_matrix_direct_frames(), 1);
+}
+
+TEST_F(RgbMatrixDirect, FlushWaitsForFrameStartedAfterRendering) {
+    frame(1, whole, {0, 2 | RGB_MATRIX_DIRECT_RUN_REPEAT, 1, 1, 1});
+    run(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    expect_shown(0, 1, 1, 1);
+
+    // The driver is still sending, so the next frame waits for it once rendered
+    direct_busy      = true;
+    uint32_t flushes = direct_flushes;
+    run(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    EXPECT_EQ(direct_flushes, flushes);
+
+    frame(2, RGB_MATRIX_DIRECT_FRAME_START, {0, 1, 2, 2, 2});
+    direct_busy = false;
+    run(RGB_MATRIX_DIRECT_TIMEOUT / 2);
+    EXPECT_EQ(direct_flushes, flushes);
+    expect_shown(0, 1, 1, 1);
+
+    frame(2, RGB_MATRIX_DIRECT_FRAME_END, {1, 1, 2, 2, 2});
+    run(2);
+    EXPECT_EQ(direct_flushes, flushes + 1);
+    expect_shown(0, 2, 2, 2);
+    expect_shown(1, 2, 2, 2);
+}
+
+TEST_F(RgbMatrixDirect, StalledFrameIsAbandoned) {
+    uint32_t flushes = direct_flushes;
+
+    frame(1, RGB_MATRIX_DIRECT_FRAME_START, {0, 1, 1, 1, 1});
+    run(RGB_MATRIX_DIRECT_TIMEOUT + RGB_MATRIX_LED_FLUSH_LIMIT);
+    EXPECT_GT(direct_flushes, flushes);
+    EXPECT_EQ(rgb_matrix_direct_dropped_frames(), 1);
+
+    // The rest of the abandoned frame is ignored
+    EXPECT_TRUE(frame(1, RGB_MATRIX_DIRECT_FRAME_END | RGB_MATRIX_DIRECT_FRAME_ACK, {1, 1, 2, 2, 2}));
+    EXPECT_EQ(report[3], rgb_matrix_direct_dropped);
+    expect_led(1, 0, 0, 0);
+}
+
+TEST_F(RgbMatrixDirect, LateFramesAreDropped) {
+    frame(5, whole, {0, 1, 5, 5, 5});
+    frame(4, whole, {0, 1, 4, 4, 4});
+    EXPECT_EQ(report[3], rgb_matrix_direct_dropped);
+    EXPECT_EQ(report[4], 5);
+    frame(5, whole, {0, 1, 6, 6, 6});
+    EXPECT_EQ(report[3], rgb_matrix_direct_dropped);
+    expect_led(0, 5, 5, 5);
+    EXPECT_EQ(rgb_matrix_direct_dropped_frames(), 2);
+
+    // Frame numbers wrap around
+    frame(250, whole, {0, 1, 7, 7, 7});
+    EXPECT_EQ(report[3], rgb_matrix_direct_dropped);
+    frame(3, whole, {0, 1, 8, 8, 8});
+    EXPECT_EQ(report[3], rgb_matrix_direct_dropped);
+    frame(6, whole, {0, 1, 9, 9, 9});
+    EXPECT_EQ(report[3], rgb_matrix_direct_ok);
+    expect_led(0, 9, 9, 9);
+}
+
+TEST_F(RgbMatrixDirect, NewFrameAbandonsIncompleteOne) {
+    frame(1, RGB_MATRIX_DIRECT_FRAME_START, {0, 1, 1, 1, 1});
+    frame(2, whole, {1, 1, 2, 2, 2});
+    EXPECT_EQ(report[3], rgb_matrix_direct_ok);
+    EXPECT_EQ(rgb_matrix_direct_dropped_frames(), 1);
+
+    // A report from another frame than the one in progress abandons it too
+    frame(3, RGB_MATRIX_DIRECT_FRAME_START, {0, 1, 3, 3, 3});
+    frame(4, RGB_MATRIX_DIRECT_FRAME_END | RGB_MATRIX_DIRECT_FRAME_ACK, {1, 1, 4, 4, 4});
+    EXPECT_EQ(report[3], rgb_matrix_direct_dropped);
+    EXPECT_FALSE(rgb_matrix_direct_receiving());
+    EXPECT_EQ(rgb_matrix_direct_dropped_frames(), 2);
+    expect_led(1, 2, 2, 2);
+}
+
+TEST_F(RgbMatrixDirect, RunsOutsideMatrixAreInvalid) {
+    frame(1, whole, {RGB_MATRIX_LED_COUNT - 1, 2 | RGB_MATRIX_DIRECT_RUN_REPEAT, 1, 1, 1});
+    EXPECT_EQ(report[3], rgb_matrix_direct_invalid);
+
+    // 9 colors do not fit in the rest of the report
+    frame(2, whole, {0, 9, 1, 1, 1});
+    EXPECT_EQ(report[3], rgb_matrix_direct_invalid);
+    EXPECT_EQ(rgb_matrix_direct_frames(), 0);
+    expect_led(RGB_MATRIX_LED_COUNT - 1, 0, 0, 0);
+}
+
+TEST_F(RgbMatrixDirect, OnlyAcksWhenAsked) {
+    EXPECT_TRUE(frame(7, RGB_MATRIX_DIRECT_FRAME_START | RGB_MATRIX_DIRECT_FRAME_END, {0, 1, 1, 2, 3}));
+    // Not replied to, the report is left as it was sent
+    EXPECT_EQ(report[3], 7);
+    EXPECT_EQ(report[4], RGB_MATRIX_DIRECT_FRAME_START | RGB_MATRIX_DIRECT_FRAME_END);
+    expect_led(0, 1, 2, 3);
+}
+
+TEST_F(RgbMatrixDirect, IgnoredOutsideDirectMode) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    frame(1, whole, {0, 1, 1, 2, 3});
+    EXPECT_EQ(report[3], rgb_matrix_direct_inactive);
+
+    send(id_rgb_matrix_direct_get_info);
+    EXPECT_EQ(report[3], rgb_matrix_direct_inactive);
+    EXPECT_EQ(report[4], RGB_MATRIX_LED_COUNT);
+}
+
+TEST_F(RgbMatrixDirect, GetInfo) {
+    frame(1, whole, {0, 1, 1, 2, 3});
+    frame(1, whole, {0, 1, 1, 2, 3});
+
+    send(id_rgb_matrix_direct_get_info);
+    EXPECT_EQ(report[3], rgb_matrix_direct_ok);
+    EXPECT_EQ(report[4], RGB_MATRIX_LED_COUNT);
+    EXPECT_EQ(report[5], 1);
+    EXPECT_EQ(report[9], 1);
+    EXPECT_EQ(report[13], 1);
+
+    send(0x42);
+    EXPECT_EQ(report[2], id_rgb_matrix_direct_unhandled);
+}
@@ -0,0 +1,9 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define BUNDLE_BENCHMARK_SCANS 1000
+
+// What the benchmark sends with the bundle tests' options but without SPLIT_TRANSPORT_BUNDLE, as the unbundled test measures it
+#define UNBUNDLED_BENCHMARK_BYTES 3970
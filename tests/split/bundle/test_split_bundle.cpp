@@ -0,0 +1,81 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../split_test.hpp"
+#include "split_bundle_bytes.hpp"
+
+extern "C" {
+#include "action_layer.h"
+#include "action_util.h"
+}
+
+class SplitBundle : public SplitTest {
+   protected:
+    serial_loopback_stats_t traffic_during_scan() {
+        serial_loopback_stats_t before, after;
+        serial_loopback_get_stats(&before);
+        scan();
+        serial_loopback_get_stats(&after);
+        after.transactions -= before.transactions;
+        after.bytes -= before.bytes;
+        return after;
+    }
+};
+
+TEST_F(SplitBundle, SlaveMatrixReachesMaster) {
+    press_slave_key(0, 9);
+    scan();
+    EXPECT_TRUE(master_sees_slave_key(0, 9));
+
+    release_slave_key(0, 9);
+    scan();
+    EXPECT_FALSE(master_sees_slave_key(0, 9));
+}
+
+TEST_F(SplitBundle, IdleScanOnlyReadsTheMatrix) {
+    serial_loopback_stats_t traffic = traffic_during_scan();
+    EXPECT_EQ(traffic.transactions, 1);
+    // The transaction ID and handshake, and the slave matrix checksum
+    EXPECT_EQ(traffic.bytes, 3);
+}
+
+TEST_F(SplitBundle, WritesGoOutTogetherWhenThatSavesBytes) {
+    layer_on(3);
+    add_mods(MOD_BIT(KC_LSFT));
+    scan();
+
+    // Queued writes reach the slave with the next scan's bundle, and are applied by its next pass
+    serial_loopback_stats_t traffic = traffic_during_scan();
+    EXPECT_EQ(traffic.transactions, 1);
+    // Fills the quarter frame exactly, two bytes less than a matrix read, a layer write and a mods write on their own
+    EXPECT_EQ(traffic.bytes, 2 + 2 + (1 + sizeof(layer_state_t)) + (1 + sizeof(split_mods_sync_t)) + 1);
+    scan();
+    EXPECT_EQ(serial_loopback_slave_layer_state(), layer_state);
+    EXPECT_EQ(serial_loopback_slave_mods(), MOD_BIT(KC_LSFT));
+}
+
+TEST_F(SplitBundle, WriteGoesOutOnItsOwnWhenABundleCostsMore) {
+    layer_on(3);
+    scan();
+
+    serial_loopback_stats_t traffic = traffic_during_scan();
+    EXPECT_EQ(traffic.transactions, 2);
+    EXPECT_EQ(traffic.bytes, 2 + 1 + 2 + sizeof(layer_state_t));
+    scan();
+    EXPECT_EQ(serial_loopback_slave_layer_state(), layer_state);
+}
+
+TEST_F(SplitBundle, QueuedWritesSurviveDroppedBundles) {
+    layer_on(1);
+    serial_loopback_set_drop_rate(100);
+    // Some of these may still reach the slave, with only the reply lost
+    scan(5);
+
+    serial_loopback_set_drop_rate(0);
+    scan(SPLIT_TRANSACTION_BACKOFF_MAX + 3);
+    EXPECT_EQ(serial_loopback_slave_layer_state(), layer_state);
+}
+
+TEST_F(SplitBundle, NoMoreBytesPerScanThanUnbundled) {
+    EXPECT_LE(benchmark_bytes_per_scan(BUNDLE_BENCHMARK_SCANS), UNBUNDLED_BENCHMARK_BYTES);
+}
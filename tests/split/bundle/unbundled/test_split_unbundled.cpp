@@ -0,0 +1,12 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../../split_test.hpp"
+#include "../split_bundle_bytes.hpp"
+
+class SplitUnbundled : public SplitTest {};
+
+TEST_F(SplitUnbundled, BytesPerScan) {
+    // The bundle tests are held to this, update it along with them when the traffic changes
+    EXPECT_EQ(benchmark_bytes_per_scan(BUNDLE_BENCHMARK_SCANS), UNBUNDLED_BENCHMARK_BYTES);
+}
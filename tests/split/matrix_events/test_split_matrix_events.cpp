@@ -0,0 +1,96 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "../split_test.hpp"
+
+class SplitMatrixEvents : public SplitTest {
+   protected:
+    void SetUp() override {
+        SplitTest::SetUp();
+        take_events();
+    }
+
+    /* Passes of the slave's main loop alone, as if the master was busy elsewhere. */
+    void slave_only(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            serial_loopback_slave_task(slave_master_matrix, slave_matrix);
+            advance_time(1);
+        }
+    }
+
+    std::vector<keyevent_t> take_events() {
+        std::vector<keyevent_t> events;
+        keyevent_t              event;
+        while (split_matrix_event_dequeue(&event)) {
+            events.push_back(event);
+        }
+        return events;
+    }
+};
+
+TEST_F(SplitMatrixEvents, EventsKeepSlaveTiming) {
+    uint16_t pressed_at = timer_read();
+    press_slave_key(1, 4);
+    slave_only(5);
+    scan();
+
+    auto events = take_events();
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].key.row % ((MATRIX_ROWS) / 2), 1);
+    EXPECT_EQ(events[0].key.col, 4);
+    EXPECT_TRUE(events[0].pressed);
+    EXPECT_EQ(events[0].time, pressed_at);
+    EXPECT_TRUE(master_sees_slave_key(1, 4));
+}
+
+TEST_F(SplitMatrixEvents, TapBetweenReadsIsNotLost) {
+    press_slave_key(0, 2);
+    slave_only(3);
+    release_slave_key(0, 2);
+    slave_only(3);
+    scan();
+
+    // The matrix alone shows nothing happened
+    EXPECT_FALSE(master_sees_slave_key(0, 2));
+    auto events = take_events();
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_TRUE(events[0].pressed);
+    EXPECT_FALSE(events[1].pressed);
+    EXPECT_EQ(events[1].time - events[0].time, 3);
+}
+
+TEST_F(SplitMatrixEvents, DroppedReadsKeepEvents) {
+    uint16_t pressed_at = timer_read();
+    press_slave_key(1, 0);
+    serial_loopback_set_drop_rate(100);
+    scan(5);
+    EXPECT_TRUE(take_events().empty());
+
+    serial_loopback_set_drop_rate(0);
+    scan(SPLIT_TRANSACTION_BACKOFF_MAX + 1);
+    auto events = take_events();
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].time, pressed_at);
+}
+
+TEST_F(SplitMatrixEvents, OverflowFallsBackToMatrix) {
+    for (uint8_t i = 0; i <= SPLIT_MATRIX_EVENTS_QUEUE_SIZE; i++) {
+        press_slave_key(i % ((MATRIX_ROWS) / 2), i / ((MATRIX_ROWS) / 2));
+        slave_only(1);
+    }
+    scan();
+
+    // Too many to tell apart, the master compares matrices instead
+    EXPECT_TRUE(take_events().empty());
+    for (uint8_t i = 0; i <= SPLIT_MATRIX_EVENTS_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(master_sees_slave_key(i % ((MATRIX_ROWS) / 2), i / ((MATRIX_ROWS) / 2)));
+    }
+}
+
+TEST_F(SplitMatrixEvents, BytesPerScan) {
+    // About 42, most of it the event queue sent on every scan
+    EXPECT_LE(benchmark_bytes_per_scan(1000), 43 * 1000);
+    take_events();
+}
@@ -0,0 +1,21 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SPLIT_TRANSPORT_BUNDLE
+
+// One LED per key, each half has two rows of the test matrix
+#define RGB_MATRIX_LED_COUNT 40
+#define RGB_MATRIX_SPLIT {20, 20}
+
+// Room for a hit recorded by each half for every key pressed in a test
+#define LED_HITS_TO_REMEMBER 16
+
+// The slave is only checked on for a restart this often, the tests wait it out
+#define FORCED_SYNC_THROTTLE_MS 100
+
+#define RGB_MATRIX_KEYPRESSES
+#define ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
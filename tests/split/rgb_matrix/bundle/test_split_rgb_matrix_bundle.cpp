@@ -0,0 +1,39 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../split_rgb_matrix_test.hpp"
+
+class SplitRgbMatrixBundle : public SplitRgbMatrix {};
+
+TEST_F(SplitRgbMatrixBundle, ConfigReachesSlave) {
+    rgb_matrix_sethsv_noeeprom(10, 20, rgb_matrix_get_val());
+    settle();
+    EXPECT_EQ(serial_loopback_slave_rgb_matrix_config().raw, rgb_matrix_config.raw);
+}
+
+TEST_F(SplitRgbMatrixBundle, HitsReachSlaveOnceWhenBundlesAreDropped) {
+    serial_loopback_set_drop_rate(50);
+    for (uint8_t i = 0; i < 6; i++) {
+        hit(i % 4, i);
+        scan(5);
+    }
+    serial_loopback_set_drop_rate(0);
+    settle();
+
+    // One recorded by the master when pressed, one by the slave when received
+    for (uint8_t i = 0; i < 6; i++) {
+        EXPECT_EQ(hits_on((i % 4) * 10 + i), 2) << "LED " << (int)((i % 4) * 10 + i);
+    }
+}
+
+TEST_F(SplitRgbMatrixBundle, EverythingResentAfterSlaveRestart) {
+    rgb_matrix_sethsv_noeeprom(30, 40, 50);
+    settle();
+
+    serial_loopback_restart_slave();
+    hit(2, 5);
+    settle();
+
+    EXPECT_EQ(serial_loopback_slave_rgb_matrix_config().raw, rgb_matrix_config.raw);
+    EXPECT_EQ(hits_on(25), 2);
+}
@@ -0,0 +1,29 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+#define ROW(r) {r * 10 + 0, r * 10 + 1, r * 10 + 2, r * 10 + 3, r * 10 + 4, r * 10 + 5, r * 10 + 6, r * 10 + 7, r * 10 + 8, r * 10 + 9}
+#define POINTS(r) {0, r * 21}, {24, r * 21}, {49, r * 21}, {74, r * 21}, {99, r * 21}, {124, r * 21}, {149, r * 21}, {174, r * 21}, {199, r * 21}, {224, r * 21}
+#define FLAGS 4, 4, 4, 4, 4, 4, 4, 4, 4, 4
+
+led_config_t g_led_config = {
+    {ROW(0), ROW(1), ROW(2), ROW(3)},
+    {POINTS(0), POINTS(1), POINTS(2), POINTS(3)},
+    {FLAGS, FLAGS, FLAGS, FLAGS},
+};
+
+static void split_init(void) {}
+
+static void split_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {}
+
+static void split_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void split_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = split_init,
+    .set_color     = split_set_color,
+    .set_color_all = split_set_color_all,
+    .flush         = split_flush,
+};
@@ -0,0 +1,57 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../split_test.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+}
+
+/* Both halves running RGB Matrix, synced without SPLIT_TRANSPORT_MIRROR. */
+class SplitRgbMatrix : public SplitTest {
+   protected:
+    void SetUp() override {
+        SplitTest::SetUp();
+
+        // Start from no hits, which are then kept for the whole test
+        rgb_matrix_init();
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_REACTIVE_SIMPLE);
+        rgb_matrix_set_speed_noeeprom(0);
+        rgb_matrix_task();
+        settle();
+    }
+
+    /* Scans long enough for anything queued to be sent, applied and acknowledged. */
+    void settle() {
+        scan(FORCED_SYNC_THROTTLE_MS + SPLIT_TRANSACTION_BACKOFF_MAX + 10);
+    }
+
+    /* A key press on the master, which records the hit and queues it for the slave. */
+    void hit(uint8_t row, uint8_t col) {
+        rgb_matrix_handle_key_event(row, col, true);
+        rgb_matrix_handle_key_event(row, col, false);
+    }
+
+    /* Hits on the LED recorded by either half, as both record into the same buffer in the test. */
+    uint8_t hits_on(uint8_t led) {
+        // The effects see the hits from the start of the next frame
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_FLUSH_LIMIT * 2; i++) {
+            rgb_matrix_task();
+            advance_time(1);
+        }
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < g_last_hit_tracker.count; i++) {
+            if (g_last_hit_tracker.index[i] == led) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    const rgb_matrix_sync_t *slave_sync() {
+        return &serial_loopback_slave_shared_memory()->rgb_matrix_sync;
+    }
+};
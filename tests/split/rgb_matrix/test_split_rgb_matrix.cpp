@@ -0,0 +1,62 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_rgb_matrix_test.hpp"
+
+class SplitRgbMatrixSync : public SplitRgbMatrix {};
+
+TEST_F(SplitRgbMatrixSync, ConfigReachesSlave) {
+    EXPECT_EQ(serial_loopback_slave_rgb_matrix_config().raw, rgb_matrix_config.raw);
+
+    rgb_matrix_sethsv_noeeprom(10, 20, rgb_matrix_get_val());
+    scan(3);
+    EXPECT_EQ(serial_loopback_slave_rgb_matrix_config().raw, rgb_matrix_config.raw);
+
+    // Only the hue and saturation bytes were sent
+    EXPECT_NE(slave_sync()->base, 0);
+    EXPECT_EQ(slave_sync()->changed, (1 << offsetof(rgb_config_t, hsv.h)) | (1 << offsetof(rgb_config_t, hsv.s)));
+    EXPECT_EQ(slave_sync()->data[0], 10);
+    EXPECT_EQ(slave_sync()->data[1], 20);
+}
+
+TEST_F(SplitRgbMatrixSync, HitsReachSlaveOnce) {
+    hit(0, 1);
+    hit(3, 2);
+    scan(3);
+    hit(1, 4);
+    settle();
+
+    // One recorded by the master when pressed, one by the slave when received
+    EXPECT_EQ(hits_on(1), 2);
+    EXPECT_EQ(hits_on(32), 2);
+    EXPECT_EQ(hits_on(14), 2);
+}
+
+TEST_F(SplitRgbMatrixSync, HitsReachSlaveOnceOverLossyLink) {
+    serial_loopback_set_drop_rate(50);
+    for (uint8_t i = 0; i < 6; i++) {
+        hit(i % 4, i);
+        scan(5);
+    }
+    serial_loopback_set_drop_rate(0);
+    settle();
+
+    for (uint8_t i = 0; i < 6; i++) {
+        EXPECT_EQ(hits_on((i % 4) * 10 + i), 2) << "LED " << (int)((i % 4) * 10 + i);
+    }
+}
+
+TEST_F(SplitRgbMatrixSync, EverythingResentAfterSlaveRestart) {
+    rgb_matrix_sethsv_noeeprom(30, 40, 50);
+    settle();
+    ASSERT_EQ(serial_loopback_slave_rgb_matrix_config().raw, rgb_matrix_config.raw);
+
+    serial_loopback_restart_slave();
+    hit(2, 5);
+    settle();
+
+    EXPECT_EQ(serial_loopback_slave_rgb_matrix_config().raw, rgb_matrix_config.raw);
+    EXPECT_EQ(slave_sync()->base, 0);
+    EXPECT_EQ(slave_sync()->changed, (1 << sizeof(rgb_matrix_sync_state_t)) - 1);
+    EXPECT_EQ(hits_on(25), 2);
+}
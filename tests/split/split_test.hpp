@@ -0,0 +1,95 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstring>
+#include <string>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "serial_loopback.h"
+#include "split_util.h"
+#include "transactions.h"
+
+void advance_time(uint32_t ms);
+}
+
+/* Both halves of a split keyboard, scanned in lockstep over the loopback serial driver. */
+class SplitTest : public TestFixture {
+   protected:
+    void SetUp() override {
+        serial_loopback_reset();
+        connect();
+    }
+
+    /* One pass of each half's main loop, the slave first as it has been scanning all along.
+     * Returns what the master's transport returned. */
+    bool scan() {
+        serial_loopback_slave_task(slave_master_matrix, slave_matrix);
+        bool okay = transport_master_if_connected(master_matrix, received_matrix);
+        advance_time(1);
+        return okay;
+    }
+
+    void scan(uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            scan();
+        }
+    }
+
+    /* Scans until the master sees the slave as connected, with nothing left backing off from earlier failures. */
+    void connect() {
+        for (uint8_t i = 0; i < 10 && !is_transport_connected(); i++) {
+            advance_time(1000);
+            scan();
+        }
+        advance_time(1000);
+        scan(2);
+        ASSERT_TRUE(is_transport_connected());
+    }
+
+    void press_slave_key(uint8_t row, uint8_t col) {
+        slave_matrix[row] |= (matrix_row_t)1 << col;
+    }
+
+    void release_slave_key(uint8_t row, uint8_t col) {
+        slave_matrix[row] &= ~((matrix_row_t)1 << col);
+    }
+
+    bool master_sees_slave_key(uint8_t row, uint8_t col) {
+        return received_matrix[row] & ((matrix_row_t)1 << col);
+    }
+
+    /* Scans while typing on the slave half, and reports the traffic it took. Returns the bytes sent in total. */
+    uint32_t benchmark_bytes_per_scan(uint32_t scans) {
+        serial_loopback_stats_t before, after;
+        serial_loopback_get_stats(&before);
+        for (uint32_t i = 0; i < scans; i++) {
+            // A key every 20 scans, held for 5
+            if (i % 20 == 0) {
+                press_slave_key((i / 20) % ((MATRIX_ROWS) / 2), (i / 40) % MATRIX_COLS);
+            } else if (i % 20 == 5) {
+                memset(slave_matrix, 0, sizeof(slave_matrix));
+            }
+            scan();
+        }
+        serial_loopback_get_stats(&after);
+
+        double bytes        = (double)(after.bytes - before.bytes) / scans;
+        double transactions = (double)(after.transactions - before.transactions) / scans;
+        RecordProperty("bytes_per_scan", std::to_string(bytes));
+        RecordProperty("transactions_per_scan", std::to_string(transactions));
+        return after.bytes - before.bytes;
+    }
+
+    // Some of the state synced to the slave is read through the host driver
+    TestDriver driver;
+
+    matrix_row_t master_matrix[(MATRIX_ROWS) / 2]       = {0};
+    matrix_row_t slave_matrix[(MATRIX_ROWS) / 2]        = {0};
+    matrix_row_t received_matrix[(MATRIX_ROWS) / 2]     = {0}; // the slave's half, as the master received it
+    matrix_row_t slave_master_matrix[(MATRIX_ROWS) / 2] = {0}; // the master's half, as the slave received it
+};
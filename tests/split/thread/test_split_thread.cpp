@@ -0,0 +1,66 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../split_test.hpp"
+
+extern "C" {
+#include "action_layer.h"
+}
+
+// Without threads on the test platform, each read runs in place as soon as it is started
+class SplitThread : public SplitTest {};
+
+TEST_F(SplitThread, SlaveMatrixArrivesWithTheNextScan) {
+    press_slave_key(1, 3);
+    scan();
+    EXPECT_FALSE(master_sees_slave_key(1, 3));
+    scan();
+    EXPECT_TRUE(master_sees_slave_key(1, 3));
+
+    release_slave_key(1, 3);
+    scan(2);
+    EXPECT_FALSE(master_sees_slave_key(1, 3));
+}
+
+TEST_F(SplitThread, OtherTransactionsStayInTheScan) {
+    layer_on(2);
+    scan();
+    EXPECT_EQ(serial_loopback_slave_shared_memory()->layers.layer_state, layer_state);
+}
+
+TEST_F(SplitThread, DroppedReadsKeepLastMatrix) {
+    press_slave_key(0, 7);
+    scan(2);
+    ASSERT_TRUE(master_sees_slave_key(0, 7));
+
+    serial_loopback_set_drop_rate(100);
+    for (uint8_t i = 0; i < 20; i++) {
+        scan();
+        EXPECT_TRUE(master_sees_slave_key(0, 7));
+    }
+    EXPECT_TRUE(is_transport_connected());
+
+    serial_loopback_set_drop_rate(0);
+    release_slave_key(0, 7);
+    scan(SPLIT_TRANSACTION_BACKOFF_MAX + 2);
+    EXPECT_FALSE(master_sees_slave_key(0, 7));
+}
+
+TEST_F(SplitThread, DisconnectsAndReconnects) {
+    serial_loopback_set_drop_rate(100);
+    for (uint16_t i = 0; i < 1000 && is_transport_connected(); i++) {
+        scan();
+    }
+    EXPECT_FALSE(is_transport_connected());
+
+    serial_loopback_set_drop_rate(0);
+    connect();
+    press_slave_key(1, 1);
+    scan(2);
+    EXPECT_TRUE(master_sees_slave_key(1, 1));
+}
+
+TEST_F(SplitThread, BytesPerScan) {
+    // The thread runs the same transactions as the main loop did
+    EXPECT_LE(benchmark_bytes_per_scan(1000), 4 * 1000);
+}
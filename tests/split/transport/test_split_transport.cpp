@@ -0,0 +1,189 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <set>
+#include <vector>
+
+#include "../split_test.hpp"
+
+extern "C" {
+#include "action_layer.h"
+#include "raw_hid.h"
+}
+
+class SplitTransport : public SplitTest {};
+
+TEST_F(SplitTransport, SlaveMatrixReachesMaster) {
+    press_slave_key(1, 3);
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(master_sees_slave_key(1, 3));
+
+    release_slave_key(1, 3);
+    EXPECT_TRUE(scan());
+    EXPECT_FALSE(master_sees_slave_key(1, 3));
+}
+
+TEST_F(SplitTransport, LayerStateReachesSlave) {
+    layer_on(2);
+    scan();
+    EXPECT_EQ(serial_loopback_slave_shared_memory()->layers.layer_state, layer_state);
+    // Applied by the slave's next pass
+    scan();
+    EXPECT_EQ(serial_loopback_slave_layer_state(), layer_state);
+
+    layer_off(2);
+    scan(2);
+    EXPECT_EQ(serial_loopback_slave_layer_state(), 0);
+}
+
+TEST_F(SplitTransport, FailureIsNotRetriedWithinTheScan) {
+    serial_loopback_stats_t before, after;
+    serial_loopback_get_stats(&before);
+
+    serial_loopback_set_drop_rate(100);
+    uint32_t start = timer_read32();
+    scan();
+
+    // The scan gives up on the first failed transaction, without waiting
+    serial_loopback_get_stats(&after);
+    EXPECT_EQ(after.transactions - before.transactions, 1);
+    EXPECT_EQ(timer_elapsed32(start), 1);
+}
+
+TEST_F(SplitTransport, DroppedTransactionsKeepLastMatrix) {
+    press_slave_key(0, 7);
+    scan();
+    ASSERT_TRUE(master_sees_slave_key(0, 7));
+
+    // Held keys are not released while the link is failing, and a short outage is not a disconnection
+    serial_loopback_set_drop_rate(100);
+    for (uint8_t i = 0; i < 20; i++) {
+        scan();
+        EXPECT_TRUE(master_sees_slave_key(0, 7));
+    }
+    EXPECT_TRUE(is_transport_connected());
+
+    // Once the backoff has passed, the slave's matrix comes through again
+    serial_loopback_set_drop_rate(0);
+    release_slave_key(0, 7);
+    scan(SPLIT_TRANSACTION_BACKOFF_MAX + 1);
+    EXPECT_FALSE(master_sees_slave_key(0, 7));
+}
+
+TEST_F(SplitTransport, BackoffDoesNotCountAsConnectionErrors) {
+    serial_loopback_stats_t before, after;
+    serial_loopback_get_stats(&before);
+
+    serial_loopback_set_drop_rate(100);
+    scan(SPLIT_TRANSACTION_BACKOFF_MAX * 4);
+
+    // Far fewer attempts than scans once the backoff grows
+    serial_loopback_get_stats(&after);
+    EXPECT_LT(after.transactions - before.transactions, SPLIT_TRANSACTION_BACKOFF_MAX * 4 / 2);
+}
+
+TEST_F(SplitTransport, ConnectionErrorsCountOnceBackoffIsLongest) {
+    serial_loopback_stats_t before, after;
+    serial_loopback_get_stats(&before);
+
+    serial_loopback_set_drop_rate(100);
+    uint32_t start = timer_read32();
+    while (is_transport_connected() && timer_elapsed32(start) < 1000) {
+        scan();
+    }
+    EXPECT_FALSE(is_transport_connected());
+
+    // Each transaction fails 4 times while its backoff doubles up to 16ms before any of them count
+    serial_loopback_get_stats(&after);
+    EXPECT_GE(after.transactions - before.transactions, 4 + 10);
+    EXPECT_GE(timer_elapsed32(start), 1 + 2 + 4 + 8 + 16);
+}
+
+TEST_F(SplitTransport, DisconnectsAndReconnects) {
+    serial_loopback_set_drop_rate(100);
+    for (uint16_t i = 0; i < 1000 && is_transport_connected(); i++) {
+        scan();
+    }
+    EXPECT_FALSE(is_transport_connected());
+
+    serial_loopback_set_drop_rate(0);
+    connect();
+    press_slave_key(1, 1);
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(master_sees_slave_key(1, 1));
+}
+
+TEST_F(SplitTransport, BitErrorsAreCaughtByChecksums) {
+    transactions_reset_stats();
+    serial_loopback_set_bit_error_rate(200);
+
+    // Corrupted matrices never get through, the master only ever has one the slave has had
+    std::set<std::vector<matrix_row_t>> had;
+    had.insert(std::vector<matrix_row_t>(slave_matrix, slave_matrix + (MATRIX_ROWS) / 2));
+    for (uint16_t i = 0; i < 2000; i++) {
+        if (i % 10 == 0) {
+            slave_matrix[i / 10 % ((MATRIX_ROWS) / 2)] ^= (matrix_row_t)1 << (i / 20 % MATRIX_COLS);
+            had.insert(std::vector<matrix_row_t>(slave_matrix, slave_matrix + (MATRIX_ROWS) / 2));
+        }
+        scan();
+        ASSERT_TRUE(had.count(std::vector<matrix_row_t>(received_matrix, received_matrix + (MATRIX_ROWS) / 2))) << "scan " << i;
+    }
+
+    serial_loopback_stats_t link;
+    serial_loopback_get_stats(&link);
+    EXPECT_GT(link.bit_errors, 0);
+
+    split_transaction_stats_t stats;
+    transaction_get_stats(GET_SLAVE_MATRIX_DATA, &stats);
+    EXPECT_GT(stats.checksum_mismatches, 0);
+}
+
+TEST_F(SplitTransport, StatsCountAttemptsAndLatency) {
+    transactions_reset_stats();
+    serial_loopback_set_latency(2);
+    scan(5);
+
+    split_transaction_stats_t stats;
+    transaction_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &stats);
+    EXPECT_EQ(stats.attempts, 5);
+    EXPECT_EQ(stats.failures, 0);
+    EXPECT_EQ(stats.worst_latency_us, 2000);
+
+    serial_loopback_set_latency(0);
+    serial_loopback_set_drop_rate(100);
+    scan();
+    transaction_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &stats);
+    EXPECT_EQ(stats.attempts, 6);
+    EXPECT_EQ(stats.failures, 1);
+}
+
+TEST_F(SplitTransport, StatsOverRawHid) {
+    uint8_t report[32];
+
+    transactions_reset_stats();
+    scan(3);
+
+    memset(report, 0, sizeof(report));
+    report[0] = RAW_HID_QUANTUM_COMMAND_ID;
+    report[1] = id_split_transaction_stats_channel;
+    report[2] = id_split_transaction_stats_get_count;
+    EXPECT_TRUE(raw_hid_receive_quantum(report, sizeof(report)));
+    EXPECT_EQ(report[3], NUM_TOTAL_TRANSACTIONS);
+    EXPECT_EQ(report[4], 1);
+
+    report[2] = id_split_transaction_stats_get;
+    report[3] = GET_SLAVE_MATRIX_CHECKSUM;
+    EXPECT_TRUE(raw_hid_receive_quantum(report, sizeof(report)));
+    EXPECT_EQ(report[7], 3);
+    EXPECT_EQ(report[11], 0);
+
+    report[2] = id_split_transaction_stats_get;
+    report[3] = NUM_TOTAL_TRANSACTIONS;
+    raw_hid_receive_quantum(report, sizeof(report));
+    EXPECT_EQ(report[2], id_split_transaction_stats_unhandled);
+}
+
+TEST_F(SplitTransport, BytesPerScan) {
+    // About 3.8, one more transaction every scan would add 2
+    EXPECT_LE(benchmark_bytes_per_scan(1000), 4 * 1000);
+}
@@ -0,0 +1,94 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+class RollStress : public TestFixture {
+   protected:
+    // Home row mods on both hands, with regular keys above them.
+    std::vector<KeymapKey> keys = {
+        KeymapKey(0, 1, 1, LSFT_T(KC_A)), KeymapKey(0, 2, 1, LCTL_T(KC_S)), KeymapKey(0, 3, 1, LALT_T(KC_D)), KeymapKey(0, 4, 1, LGUI_T(KC_F)),    //
+        KeymapKey(0, 5, 1, RGUI_T(KC_J)), KeymapKey(0, 6, 1, RALT_T(KC_K)), KeymapKey(0, 7, 1, RCTL_T(KC_L)), KeymapKey(0, 8, 1, RSFT_T(KC_SCLN)), //
+        KeymapKey(0, 1, 0, KC_Q),         KeymapKey(0, 2, 0, KC_W),         KeymapKey(0, 3, 0, KC_E),         KeymapKey(0, 4, 0, KC_R),            //
+        KeymapKey(0, 5, 0, KC_U),         KeymapKey(0, 6, 0, KC_I),         KeymapKey(0, 7, 0, KC_O),         KeymapKey(0, 8, 0, KC_P),
+    };
+
+    void SetUp() override {
+        for (const auto &key : keys) {
+            add_key(key);
+        }
+    }
+
+    /* Deterministic xorshift, so every run types the same roll */
+    uint32_t next_random() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    /* Types `events` presses and releases as overlapping rolls of up to three keys */
+    void roll(uint32_t events) {
+        std::deque<size_t> held;
+        std::vector<bool>  is_held(keys.size(), false);
+
+        for (uint32_t i = 0; i < events; i++) {
+            if (held.empty() || (held.size() < 3 && next_random() % 2)) {
+                size_t k;
+                do {
+                    k = next_random() % keys.size();
+                } while (is_held[k]);
+                keys[k].press();
+                held.push_back(k);
+                is_held[k] = true;
+            } else {
+                size_t k = held.front();
+                keys[k].release();
+                held.pop_front();
+                is_held[k] = false;
+            }
+            run_one_scan_loop();
+            idle_for(next_random() % 40);
+        }
+
+        while (!held.empty()) {
+            keys[held.front()].release();
+            held.pop_front();
+            run_one_scan_loop();
+        }
+    }
+
+    uint32_t seed = 0x12345678;
+};
+
+TEST_F(RollStress, long_roll_leaves_no_keys_held) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    const uint32_t events = 10000;
+    auto           start  = std::chrono::steady_clock::now();
+    roll(events);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    idle_for(2 * TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(get_mods(), 0);
+    EXPECT_FALSE(has_anykey());
+
+    // Includes the idle scans between events, compare runs of the same build only.
+    RecordProperty("events", events);
+    RecordProperty("ns_per_event", elapsed.count() / events);
+}
@@ -0,0 +1,72 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "task_deadline.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class TaskDeadline : public TestFixture {};
+
+TEST_F(TaskDeadline, idle_keyboard_skips_ticks) {
+    TestDriver driver;
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+    set_keymap({regular_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(action_tick_pending());
+}
+
+TEST_F(TaskDeadline, unsettled_mod_tap_is_settled_by_ticks) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    set_keymap({mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(action_tick_pending());
+    VERIFY_AND_CLEAR(driver);
+
+    // Only tick events can settle the key as held
+    EXPECT_REPORT(driver, (KC_LSFT));
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(action_tick_pending());
+}
+
+TEST_F(TaskDeadline, caps_word_times_out_on_its_deadline) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    caps_word_on();
+    run_one_scan_loop();
+    // The task has run and registered its idle timeout
+    EXPECT_FALSE(task_deadline_due(TASK_DEADLINE_CAPS_WORD));
+
+    idle_for(CAPS_WORD_IDLE_TIMEOUT - 10);
+    EXPECT_TRUE(is_caps_word_on());
+
+    idle_for(20);
+    EXPECT_FALSE(is_caps_word_on());
+    EXPECT_FALSE(task_deadline_due(TASK_DEADLINE_CAPS_WORD));
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,125 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "raw_hid.h"
+#include "task_profiling.h"
+}
+
+using testing::_;
+
+class TaskProfiling : public TestFixture {
+   protected:
+    void SetUp() override {
+        task_profiling_reset();
+    }
+
+    task_profiling_stats_t stats(task_profiling_stage_t stage) {
+        task_profiling_stats_t result;
+        task_profiling_get_stats(stage, &result);
+        return result;
+    }
+};
+
+TEST_F(TaskProfiling, EmptyHistogramReportsZero) {
+    auto result = stats(TASK_PROFILING_MATRIX);
+    EXPECT_EQ(result.samples, 0);
+    EXPECT_EQ(result.min_us, 0);
+    EXPECT_EQ(result.max_us, 0);
+    EXPECT_EQ(result.p50_us, 0);
+    EXPECT_EQ(result.p99_us, 0);
+}
+
+TEST_F(TaskProfiling, SmallValuesAreExact) {
+    for (uint32_t us = 0; us < 4; us++) {
+        task_profiling_record(TASK_PROFILING_MATRIX, us);
+    }
+    auto result = stats(TASK_PROFILING_MATRIX);
+    EXPECT_EQ(result.samples, 4);
+    EXPECT_EQ(result.min_us, 0);
+    EXPECT_EQ(result.max_us, 3);
+    EXPECT_EQ(result.p50_us, 1);
+    EXPECT_EQ(result.p99_us, 3);
+}
+
+TEST_F(TaskProfiling, PercentilesFollowDistribution) {
+    for (int i = 0; i < 990; i++) {
+        task_profiling_record(TASK_PROFILING_QUANTUM, 100);
+    }
+    for (int i = 0; i < 10; i++) {
+        task_profiling_record(TASK_PROFILING_QUANTUM, 5000);
+    }
+    auto result = stats(TASK_PROFILING_QUANTUM);
+    EXPECT_EQ(result.samples, 1000);
+    EXPECT_EQ(result.min_us, 100);
+    EXPECT_EQ(result.max_us, 5000);
+    // 100us lands in the 96-127us bucket
+    EXPECT_EQ(result.p50_us, 127);
+    EXPECT_EQ(result.p99_us, 127);
+
+    task_profiling_record(TASK_PROFILING_QUANTUM, 5000);
+    result = stats(TASK_PROFILING_QUANTUM);
+    EXPECT_EQ(result.p99_us, 5000);
+}
+
+TEST_F(TaskProfiling, SaturatedBucketsKeepShape) {
+    for (uint32_t i = 0; i < 300000; i++) {
+        task_profiling_record(TASK_PROFILING_LED, i % 4 == 0 ? 1000 : 10);
+    }
+    auto result = stats(TASK_PROFILING_LED);
+    EXPECT_EQ(result.samples, 300000);
+    EXPECT_EQ(result.p50_us, 11);
+    EXPECT_EQ(result.p99_us, 1000);
+}
+
+TEST_F(TaskProfiling, KeyboardTaskRecordsEveryStage) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    run_one_scan_loop();
+
+    for (uint8_t stage = 0; stage < TASK_PROFILING_STAGE_COUNT; stage++) {
+        EXPECT_EQ(stats((task_profiling_stage_t)stage).samples, 2) << task_profiling_stage_name((task_profiling_stage_t)stage);
+    }
+    // run_one_scan_loop() advances the clock by 1ms after keyboard_task() returns
+    EXPECT_EQ(stats(TASK_PROFILING_KEYBOARD_TASK).max_us, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TaskProfiling, RawHidQueries) {
+    task_profiling_record(TASK_PROFILING_MATRIX, 300);
+
+    uint8_t data[32] = {0xFD, id_task_profiling_channel, id_task_profiling_get_stage_count};
+    task_profiling_raw_hid_receive(data, sizeof(data));
+    EXPECT_EQ(data[2], id_task_profiling_get_stage_count);
+    EXPECT_EQ(data[3], TASK_PROFILING_STAGE_COUNT);
+
+    memset(data, 0, sizeof(data));
+    data[2] = id_task_profiling_get_stage_stats;
+    data[3] = TASK_PROFILING_MATRIX;
+    task_profiling_raw_hid_receive(data, sizeof(data));
+    EXPECT_EQ(data[2], id_task_profiling_get_stage_stats);
+    EXPECT_EQ(data[7], 1);                           // samples
+    EXPECT_EQ((data[10] << 8) | data[11], 300);      // min
+    EXPECT_EQ((data[14] << 8) | data[15], 300);      // max
+
+    memset(data, 0, sizeof(data));
+    data[2] = id_task_profiling_get_stage_name;
+    data[3] = TASK_PROFILING_MATRIX;
+    task_profiling_raw_hid_receive(data, sizeof(data));
+    EXPECT_STREQ((const char *)&data[4], "matrix");
+
+    data[2] = id_task_profiling_get_stage_stats;
+    data[3] = TASK_PROFILING_STAGE_COUNT;
+    task_profiling_raw_hid_receive(data, sizeof(data));
+    EXPECT_EQ(data[2], id_task_profiling_unhandled);
+
+    data[2] = id_task_profiling_reset;
+    task_profiling_raw_hid_receive(data, sizeof(data));
+    EXPECT_EQ(stats(TASK_PROFILING_MATRIX).samples, 0);
+}
@@ -161,7 +161,9 @@ void raw_hid_task(void) {
     }
 
     if (raw_output_received_bytes == RAW_BUFFER_SIZE) {
-        raw_hid_receive(raw_output_buffer, RAW_BUFFER_SIZE);
+        if (!raw_hid_receive_quantum(raw_output_buffer, RAW_BUFFER_SIZE)) {
+            raw_hid_receive(raw_output_buffer, RAW_BUFFER_SIZE);
+        }
         raw_output_received_bytes = 0;
     }
 }